@@ -0,0 +1,260 @@
+/**
+ * @file    MatrixLayout.cpp
+ * @brief   Benchmark of the layouts of the Matrix: vector of vectors, flat vector and std::array.
+ *
+ *  Resolves the former TODO of the Matrix, comparing the costs of construction, copy and usage on the real
+ * workloads of the engine, with the time per operation and the cache misses per operation (Linux perf events).
+ *
+ *  Best ns/op of 9 runs on a Release build (single core VM, runs varying by up to 2x, so only large ratios count):
+ *
+ *  layout    construct   init  findShortest  copy  scan  walk
+ *  vectors         209     43           271    54    42    86
+ *  flat             46     52           268   5.4    32    95
+ *  checked          48     52           332   5.7    61   115
+ *  array            48     58           213   2.8    34    95
+ *
+ *  The flat Matrix is chosen for its construction (4.5x faster, a single allocation) and its copy (10x faster),
+ * not for its usage: findShortest is a tie with the vector of vectors, and init and walk are even 10 to 20% slower.
+ * std::array is not constructed faster than the flat vector, and is only faster in findShortest (by 20%, its width
+ * being known at compile time) for a size fixed at compile time. The checks of the coordinates cost 25% of
+ * findShortest, so they are only enabled in Debug builds.
+ *
+ * Copyright (c) 2015 Sebastien Rombauts (sebastien.rombauts@gmail.com, http://srombauts.github.io)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#define THEGREATESCAPE_BENCHMARK
+#include "Main.cpp" // NOLINT(build/include)
+#include "Measure.h"
+
+#include <array>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/// Nb of operations of each measure
+static const size_t Operations = 200000;
+
+/// Original layout: vector of columns, each one a vector of elements (without the checks of vector::at())
+template <typename TElement>
+class VectorsMatrix {
+public:
+    /// ctor allocating the matrix to the specified size with explicit initialisation
+    VectorsMatrix(const size_t aWidthX, const size_t aHeightY, const TElement& aInitValue) :
+        mMatrix(aWidthX, std::vector<TElement>(aHeightY, aInitValue)) {
+    }
+    /// Initialize all the matrix with the provided value
+    void init(const TElement& aInitValue) {
+        for (auto& column : mMatrix) {
+            for (auto& cell : column) {
+                cell = aInitValue;
+            }
+        }
+    }
+    /// getter for cell at [X, Y]
+    const TElement& get(const Coords& aCoords) const {
+        return mMatrix[aCoords.x][aCoords.y];
+    }
+    /// "setter" for cell at [X, Y]
+    TElement& set(const Coords& aCoords) {
+        return mMatrix[aCoords.x][aCoords.y];
+    }
+
+private:
+    std::vector<std::vector<TElement>> mMatrix; ///< Matrix as a vector of columns
+};
+
+/// Fixed size layout: std::array of the elements line after line, without any allocation
+template <typename TElement, size_t TWidth, size_t THeight>
+class ArrayMatrix {
+public:
+    /// ctor of the matrix of the size given by the template parameters, with explicit initialisation
+    ArrayMatrix(const size_t /* aWidthX */, const size_t /* aHeightY */, const TElement& aInitValue) {
+        mMatrix.fill(aInitValue);
+    }
+    /// Initialize all the matrix with the provided value
+    void init(const TElement& aInitValue) {
+        mMatrix.fill(aInitValue);
+    }
+    /// getter for cell at [X, Y]
+    const TElement& get(const Coords& aCoords) const {
+        return mMatrix[aCoords.y * TWidth + aCoords.x];
+    }
+    /// "setter" for cell at [X, Y]
+    TElement& set(const Coords& aCoords) {
+        return mMatrix[aCoords.y * TWidth + aCoords.x];
+    }
+
+private:
+    std::array<TElement, TWidth * THeight> mMatrix; ///< Elements line after line
+};
+
+/// Hardware counter of the cache misses of the process, when the Linux perf events are available
+class CacheMisses {
+public:
+    /// Open the counter (disabled)
+    CacheMisses() : mFd(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.size           = sizeof(attr);
+        attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        mFd = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    /// Close the counter
+    ~CacheMisses() {
+#ifdef __linux__
+        if (isAvailable()) {
+            close(mFd);
+        }
+#endif
+    }
+
+    /// Is the counter available (not on other systems, nor when forbidden by perf_event_paranoid)
+    bool isAvailable() const {
+        return (mFd >= 0);
+    }
+    /// Reset and start counting
+    void start() {
+#ifdef __linux__
+        if (isAvailable()) {
+            ioctl(mFd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(mFd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    /// Stop counting, and get the count since start()
+    uint64_t get() {
+        uint64_t count = 0;
+#ifdef __linux__
+        if (isAvailable()) {
+            ioctl(mFd, PERF_EVENT_IOC_DISABLE, 0);
+            if (sizeof(count) != read(mFd, &count, sizeof(count))) {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+
+private:
+    int mFd;    ///< File descriptor of the perf event
+};
+
+/**
+ * Measure a workload: best time of the runs, and the cache misses of that run
+ *
+ * @param[in]  apLayout     Name of the layout of the Matrix
+ * @param[in]  apWorkload   Name of the workload
+ * @param[in]  aWorkload    Function object running one operation of the workload
+ */
+template <class TWorkload>
+void measure(const char* apLayout, const char* apWorkload, TWorkload aWorkload) {
+    CacheMisses     cacheMisses;
+    uint64_t        bestMisses = 0;
+    const double    bestDuration = bestOfRuns([&] {
+        for (size_t operation = 0; operation < Operations; ++operation) {
+            aWorkload();
+        }
+    }, cacheMisses, bestMisses);
+    std::cout << std::left << std::setw(10) << apLayout << std::setw(14) << apWorkload << std::right;
+    printNsPerOp(bestDuration, Operations);
+    if (cacheMisses.isAvailable()) {
+        std::cout << std::setw(14) << std::setprecision(3)
+                  << (static_cast<double>(bestMisses) / static_cast<double>(Operations));
+    } else {
+        std::cout << std::setw(14) << "n/a";
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * Run the workloads of the engine on a layout of the Matrix of Cell
+ *
+ * @param[in]  apLayout     Name of the layout of the Matrix
+ * @param[in]  aBoard       Bitboard of the walls, of the size of the game
+ */
+template <class TMatrix>
+void measureLayout(const char* apLayout, const Board& aBoard) {
+    const Cell  unknown{ Cell::Unreachable, eNone };
+    TMatrix     paths(aBoard.width(), aBoard.height(), unknown);
+    TMatrix     copy(aBoard.width(), aBoard.height(), unknown);
+
+    // as at each turn for each player: new matrix, then reset, and shortest paths toward the goal side
+    measure(apLayout, "construct", [&] {
+        TMatrix matrix(aBoard.width(), aBoard.height(), unknown);
+        gSink = gSink + matrix.get(Coords{ 0, 0 }).distance;
+    });
+    measure(apLayout, "init", [&] {
+        paths.init(unknown);
+        gSink = gSink + paths.get(Coords{ 0, 0 }).distance;
+    });
+    measure(apLayout, "findShortest", [&] {
+        paths.init(unknown);
+        aBoard.findShortest(paths, eRight);
+        gSink = gSink + paths.get(Coords{ 0, 0 }).distance;
+    });
+    // copy of the paths of a player (as the nextCollisions copy of main(), before the bitboard of walls)
+    measure(apLayout, "copy", [&] {
+        copy = paths;
+        gSink = gSink + copy.get(Coords{ 0, 0 }).distance;
+    });
+    // read of every cell line after line (as the scans of the replacement paths and of the dumps)
+    measure(apLayout, "scan", [&] {
+        size_t sum = 0;
+        for (size_t y = 0; y < aBoard.height(); ++y) {
+            for (size_t x = 0; x < aBoard.width(); ++x) {
+                sum += paths.get(Coords{ x, y }).distance;
+            }
+        }
+        gSink = gSink + sum;
+    });
+    // walk of the shortest path of each cell of the first column (as the construction of the detours)
+    measure(apLayout, "walk", [&] {
+        size_t steps = 0;
+        for (size_t y = 0; y < aBoard.height(); ++y) {
+            Coords coords{ 0, y };
+            for (EDirection direction = paths.get(coords).direction; direction != eNone;
+                 direction = paths.get(coords).direction) {
+                coords = coords.next(direction);
+                ++steps;
+            }
+        }
+        gSink = gSink + steps;
+    });
+}
+
+/**
+ * Compare the layouts of the Matrix of Cell on the 9x9 board of the game
+ *
+ * @return 0
+ */
+int main() {
+    Board board(GameSize::width(), GameSize::height());
+    const Wall walls[] = { Wall{ Coords{ 1, 1 }, 'H' }, Wall{ Coords{ 3, 1 }, 'H' }, Wall{ Coords{ 5, 2 }, 'V' },
+                           Wall{ Coords{ 2, 4 }, 'V' }, Wall{ Coords{ 4, 6 }, 'H' }, Wall{ Coords{ 6, 6 }, 'H' },
+                           Wall{ Coords{ 7, 3 }, 'V' } };
+    for (const auto& wall : walls) {
+        board.addWall(wall);
+    }
+
+    std::cout << "layout    workload         ns/op   misses/op\n";
+    measureLayout<VectorsMatrix<Cell>>("vectors", board);
+    measureLayout<Matrix<Cell, UncheckedAccess>>("flat", board);
+    measureLayout<Matrix<Cell, CheckedAccess>>("checked", board);
+    measureLayout<ArrayMatrix<Cell, GameSize::width(), GameSize::height()>>("array", board);
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file    Measure.h
+ * @brief   Helpers shared by the benchmarks: best time of the runs of a workload, and mute of the debug output.
+ *
+ *  Included by each benchmark right after Main.cpp, whose Measure of time it uses (one translation unit each).
+ *
+ * Copyright (c) 2015 Sebastien Rombauts (sebastien.rombauts@gmail.com, http://srombauts.github.io)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+
+/// Nb of measures of each workload, keeping the best one
+static const size_t Runs = 5;
+/// Sink of the results of the workloads, so that they are not optimized away
+static volatile size_t gSink = 0;
+
+/// Probe counting nothing, for the measures of time alone (see the CacheMisses of the MatrixLayout benchmark)
+class NoProbe {
+public:
+    /// Reset and start counting
+    void start() {
+    }
+    /// Stop counting, and get the count since start()
+    uint64_t get() {
+        return 0;
+    }
+};
+
+/**
+ * Best time of the runs of a workload, with the count of a probe during that run
+ *
+ * @param[in]     aWorkload     Function object running the whole workload once
+ * @param[in,out] aProbe        Counter started and read around each run, as NoProbe
+ * @param[out]    aBestCount    Count of the probe during the best run
+ *
+ * @return Duration of the best run (ms)
+ */
+template <class TWorkload, class TProbe>
+double bestOfRuns(TWorkload aWorkload, TProbe& aProbe, uint64_t& aBestCount) {
+    double bestDuration = std::numeric_limits<double>::max();
+    for (size_t run = 0; run < Runs; ++run) {
+        Measure time;
+        aProbe.start();
+        time.start();
+        aWorkload();
+        const double duration = time.get();
+        const uint64_t count = aProbe.get();
+        if (duration < bestDuration) {
+            bestDuration = duration;
+            aBestCount   = count;
+        }
+    }
+    return bestDuration;
+}
+
+/**
+ * Best time of the runs of a workload
+ *
+ * @param[in]  aWorkload    Function object running the whole workload once
+ *
+ * @return Duration of the best run (ms)
+ */
+template <class TWorkload>
+double bestOfRuns(TWorkload aWorkload) {
+    NoProbe     probe;
+    uint64_t    count = 0;
+    return bestOfRuns(aWorkload, probe, count);
+}
+
+/**
+ * Print the time of one operation, as a column of the results
+ *
+ * @param[in]  aDuration    Duration of all the operations (ms)
+ * @param[in]  aOperations  Nb of operations
+ */
+void printNsPerOp(const double aDuration, const size_t aOperations) {
+    std::cout << std::setw(10) << std::fixed << std::setprecision(1)
+              << (1000000.0 * aDuration / static_cast<double>(aOperations));
+}
+
+/// Mute the debug output of the engine (std::cerr) for the lifetime of the object
+class MuteDebug {
+public:
+    /// Mute the debug output
+    MuteDebug() : mpDebug(std::cerr.rdbuf(nullptr)) {
+    }
+    /// Restore the debug output
+    ~MuteDebug() {
+        std::cerr.rdbuf(mpDebug);
+    }
+
+private:
+    /// Not copyable: only one object restores the debug output
+    MuteDebug(const MuteDebug&);
+    MuteDebug& operator=(const MuteDebug&);
+
+private:
+    std::streambuf* mpDebug;    ///< Buffer of the debug output, restored by the dtor
+};
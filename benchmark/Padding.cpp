@@ -0,0 +1,228 @@
+/**
+ * @file    Padding.cpp
+ * @brief   Benchmark of the sentinel-padded Board against the previous layout checking the coordinates.
+ *
+ *  The previous layout indexed each edge by the cell on its left or upper side: a neighbor test had to check
+ * the coordinates against the borders of the board, and the bitboard loops to mask the shifts by the cells inside
+ * the board. The Board now blocks the border edges permanently (sentinels), on boards with many walls here.
+ *
+ * Copyright (c) 2015 Sebastien Rombauts (sebastien.rombauts@gmail.com, http://srombauts.github.io)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#define THEGREATESCAPE_BENCHMARK
+#include "Main.cpp" // NOLINT(build/include)
+#include "Measure.h"
+
+#include <random>
+
+/// Nb of random boards
+static const size_t Boards = 100;
+/// Nb of walls of each board (dense: about twice the walls of a game of 3 players)
+static const size_t Walls = 40;
+/// Nb of times each workload runs on all the boards
+static const size_t Repeats = 2000;
+
+/// Previous layout of the Board, on the 9x9 board of the game
+class MaskedBoard {
+public:
+    /// ctor of an empty board without any wall
+    MaskedBoard() :
+        mWidth(GameSize::width()),
+        mHeight(GameSize::height()),
+        mInside{ BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{} },
+        mBlockedRight{},
+        mBlockedDown{} {
+        for (size_t y = 0; y < mHeight; ++y) {
+            for (size_t x = 0; x < mWidth; ++x) {
+                const size_t idx = y * mWidth + x;
+                if (x < mWidth - 1) {
+                    mInside[eRight].set(idx);
+                }
+                if (x > 0) {
+                    mInside[eLeft].set(idx);
+                }
+                if (y < mHeight - 1) {
+                    mInside[eDown].set(idx);
+                }
+                if (y > 0) {
+                    mInside[eUp].set(idx);
+                }
+            }
+        }
+    }
+
+    /// Set a wall into the bitboard: the pair of edges it blocks
+    void addWall(const Wall& aWall) {
+        if (aWall.orientation == 'H') {
+            const size_t idx = (aWall.coords.y - 1) * mWidth + aWall.coords.x;
+            mBlockedDown |= BitBoard::bit(idx) | BitBoard::bit(idx + 1);
+        } else {
+            const size_t idx = aWall.coords.y * mWidth + aWall.coords.x - 1;
+            mBlockedRight |= BitBoard::bit(idx) | BitBoard::bit(idx + mWidth);
+        }
+    }
+
+    /// Is a move possible from the cell into the given direction, checking the coordinates against the borders
+    bool isPassable(const Coords& aCoords, const EDirection aDirection) const {
+        const size_t idx = aCoords.y * mWidth + aCoords.x;
+        bool bIsPassable;
+        switch (aDirection) {
+        case eRight:    bIsPassable = (aCoords.x < mWidth - 1)  && !mBlockedRight.test(idx);         break;
+        case eLeft:     bIsPassable = (aCoords.x > 0)           && !mBlockedRight.test(idx - 1);     break;
+        case eDown:     bIsPassable = (aCoords.y < mHeight - 1) && !mBlockedDown.test(idx);          break;
+        case eUp:       bIsPassable = (aCoords.y > 0)           && !mBlockedDown.test(idx - mWidth); break;
+        case eNone:
+        default:
+            throw std::logic_error("isPassable: default");
+        }
+        return bIsPassable;
+    }
+
+    /// Connectivity check by flood fill, masking the shifts by the cells inside the board
+    bool isReachable(const Coords& aCoords, const EDirection aOrientation) const {
+        const BitBoard target = GameSize::goal(aOrientation);
+        const BitBoard right  = mInside[eRight] & ~mBlockedRight;
+        const BitBoard left   = mInside[eLeft]  & ~(mBlockedRight << 1);
+        const BitBoard down   = mInside[eDown]  & ~mBlockedDown;
+        const BitBoard up     = mInside[eUp]    & ~(mBlockedDown << GameSize::width());
+        BitBoard area{};
+        area.set(aCoords.y * GameSize::width() + aCoords.x);
+        BitBoard grown = area;
+        while (grown.any() && !(area & target).any()) {
+            const BitBoard next = area | ((area & right) << 1) | ((area & left) >> 1)
+                                       | ((area & down) << GameSize::width()) | ((area & up) >> GameSize::width());
+            grown = next & ~area;
+            area  = next;
+        }
+        return (area & target).any();
+    }
+
+private:
+    size_t      mWidth;         ///< Nb of columns (X axis)
+    size_t      mHeight;        ///< Nb of lines (Y axis)
+    BitBoard    mInside[5];     ///< cells from which a move stays inside the board, by direction
+    BitBoard    mBlockedRight;  ///< edges blocked by a wall, by cell from which the move to the right is blocked
+    BitBoard    mBlockedDown;   ///< edges blocked by a wall, by cell from which the move to the bottom is blocked
+};
+
+/// Nb of moves possible from all the cells: the neighbor loop of the kernel, the DAG and the detours
+template <class TBoard>
+size_t countMoves(const TBoard& aBoard) {
+    size_t moves = 0;
+    for (size_t y = 0; y < GameSize::height(); ++y) {
+        for (size_t x = 0; x < GameSize::width(); ++x) {
+            for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+                moves += aBoard.isPassable(Coords{ x, y }, direction) ? 1 : 0;
+            }
+        }
+    }
+    return moves;
+}
+
+/// Nb of cells reached by a breadth-first search cell by cell from the center, as in the repair of the paths
+template <class TBoard>
+size_t countReached(const TBoard& aBoard) {
+    bool    bIsReached[GameSize::cells()] = {};
+    Coords  queue[GameSize::cells()];
+    size_t  first = 0;
+    size_t  last = 0;
+    queue[last++] = Coords{ GameSize::width() / 2, GameSize::height() / 2 };
+    bIsReached[(GameSize::height() / 2) * GameSize::width() + GameSize::width() / 2] = true;
+    while (first < last) {
+        const Coords coords = queue[first++];
+        for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+            if (aBoard.isPassable(coords, direction)) {
+                const Coords next = coords.next(direction);
+                const size_t idx = next.y * GameSize::width() + next.x;
+                if (!bIsReached[idx]) {
+                    bIsReached[idx] = true;
+                    queue[last++] = next;
+                }
+            }
+        }
+    }
+    return last;
+}
+
+/// Nb of the players able to reach their goal side: the connectivity check of each candidate wall
+template <class TBoard>
+size_t countReachable(const TBoard& aBoard) {
+    size_t reachable = 0;
+    for (const EDirection orientation : {eRight, eLeft, eDown}) {
+        reachable += aBoard.isReachable(Coords{ GameSize::width() / 2, GameSize::height() / 2 }, orientation) ? 1 : 0;
+    }
+    return reachable;
+}
+
+/**
+ * Measure a workload on all the boards of a layout: best time of the runs
+ *
+ * @param[in]  apLayout     Name of the layout of the Board
+ * @param[in]  apWorkload   Name of the workload
+ * @param[in]  aBoards      Boards of the layout
+ * @param[in]  aWorkload    Function object running the workload on one board
+ */
+template <class TBoard, class TWorkload>
+void measure(const char* apLayout, const char* apWorkload, const std::vector<TBoard>& aBoards, TWorkload aWorkload) {
+    const double bestDuration = bestOfRuns([&] {
+        for (size_t repeat = 0; repeat < Repeats; ++repeat) {
+            for (const auto& board : aBoards) {
+                gSink = gSink + aWorkload(board);
+            }
+        }
+    });
+    std::cout << std::left << std::setw(10) << apLayout << std::setw(14) << apWorkload << std::right;
+    printNsPerOp(bestDuration, Repeats * Boards);
+    std::cout << std::endl;
+}
+
+/// Run the workloads on all the boards of a layout
+template <class TBoard>
+void measureLayout(const char* apLayout, const std::vector<TBoard>& aBoards) {
+    measure(apLayout, "moves", aBoards, countMoves<TBoard>);
+    measure(apLayout, "bfs", aBoards, countReached<TBoard>);
+    measure(apLayout, "reachable", aBoards, countReachable<TBoard>);
+}
+
+/**
+ * Compare the layouts of the Board on random 9x9 boards with many walls
+ *
+ * @return 0
+ */
+int main() {
+    const MuteDebug             muteDebug;
+    std::mt19937                random(15);
+    std::vector<Board>          paddedBoards;
+    std::vector<MaskedBoard>    maskedBoards;
+    for (size_t idx = 0; idx < Boards; ++idx) {
+        Board           board(GameSize::width(), GameSize::height());
+        MaskedBoard     maskedBoard;
+        LegalWalls      legalWalls(GameSize::width(), GameSize::height());
+        Wall::Vector    walls;
+        for (size_t attempt = 0; (attempt < 100 * Walls) && (walls.size() < Walls); ++attempt) {
+            const Wall wall{ Coords{ random() % GameSize::width(), random() % GameSize::height() },
+                             (0 == random() % 2) ? 'H' : 'V' };
+            if (legalWalls.isLegal(wall)) {
+                walls.push_back(wall);
+                legalWalls.addWall(wall);
+                board.addWall(wall);
+                maskedBoard.addWall(wall);
+            }
+        }
+        if ((countMoves(board) != countMoves(maskedBoard)) || (countReached(board) != countReached(maskedBoard))
+            || (countReachable(board) != countReachable(maskedBoard))) {
+            throw std::logic_error("Padding: layouts differ");
+        }
+        paddedBoards.push_back(board);
+        maskedBoards.push_back(maskedBoard);
+    }
+
+    std::cout << "layout    workload         ns/op\n";
+    measureLayout("masked", maskedBoards);
+    measureLayout("padded", paddedBoards);
+
+    return 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file    Position.cpp
+ * @brief   Benchmark of the compact Position against the copy of the players and the walls of a turn.
+ *
+ *  A lookahead search copies, or plays and takes back, a position at each of its nodes: the Position is copied
+ * as 64 bytes and make()/unmake() update it in place, where each Player of a turn owns its paths and its detours
+ * on the heap. Each random move is first checked against the Position built from scratch after the same move.
+ *
+ * Copyright (c) 2015 Sebastien Rombauts (sebastien.rombauts@gmail.com, http://srombauts.github.io)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#define THEGREATESCAPE_BENCHMARK
+#include "Main.cpp" // NOLINT(build/include)
+#include "Measure.h"
+
+#include <random>
+
+/// Nb of random positions
+static const size_t Positions = 100;
+/// Nb of moves played from each position
+static const size_t Moves = 20;
+/// Nb of times each workload runs on all the positions
+static const size_t Repeats = 200;
+
+/// Random position of a game on the 9x9 board: players spread over the board, with some walls already put
+struct Game {
+    Player::Vector                  players;    ///< Players of the game, all alive
+    Wall::Vector                    walls;      ///< Walls of the board
+    std::vector<Position::Move>     moves;      ///< Random moves played from the position
+    Position                        position;   ///< Position of the game, before the moves
+
+    /// dtor
+    ~Game();
+};
+Game::~Game() = default;
+
+/// Random move of the player to move: a step staying inside the board, or else a wall compatible with the walls
+Position::Move randomMove(const Position& aPosition, std::mt19937& aRandom) {
+    Position::Move move{ eNone, Wall{ Coords{ 0, 0 }, 'H' } };
+    const size_t id = aPosition.playerToMove();
+    if ((aPosition.wallsLeft(id) > 0) && (0 == aRandom() % 3)) {
+        do {
+            move.wall = Wall{ Coords{ aRandom() % GameSize::width(), aRandom() % GameSize::height() },
+                              (0 == aRandom() % 2) ? 'H' : 'V' };
+        } while (!aPosition.isLegal(move.wall));
+    } else {
+        Coords next;
+        do {
+            move.direction = static_cast<EDirection>(eRight + aRandom() % 4);
+            next = aPosition.coords(id).next(move.direction);
+        } while ((next.x >= GameSize::width()) || (next.y >= GameSize::height()));
+    }
+    return move;
+}
+
+/// Play a move on the players and the walls of a turn, as make() does on the Position
+void play(const Position::Move& aMove, const size_t aId, Player::Vector& aPlayers, Wall::Vector& aWalls) {
+    Player& player = aPlayers[aId];
+    if (eNone != aMove.direction) {
+        player.coords = player.coords.next(aMove.direction);
+    } else {
+        aWalls.push_back(aMove.wall);
+        --player.wallsLeft;
+    }
+}
+
+/// Are two positions equal, through their interface
+bool isEqual(const Position& aA, const Position& aB, const size_t aPlayerCount) {
+    bool bIsEqual = (aA.hash() == aB.hash()) && (aA.playerToMove() == aB.playerToMove());
+    for (size_t id = 0; id < aPlayerCount; ++id) {
+        bIsEqual &= (aA.coords(id) == aB.coords(id)) && (aA.wallsLeft(id) == aB.wallsLeft(id));
+    }
+    return bIsEqual;
+}
+
+/**
+ * Random game, with its random moves checked against the Position built from scratch after each of them
+ *
+ * @param[in]  aPlayerCount Nb of players (2 to 4)
+ * @param[in]  aRandom      Random generator
+ *
+ * @return Random game
+ */
+Game randomGame(const size_t aPlayerCount, std::mt19937& aRandom) {
+    Player::Vector  startPlayers;
+    Wall::Vector    startWalls;
+    startPlayers.reserve(aPlayerCount);
+    for (size_t id = 0; id < aPlayerCount; ++id) {
+        startPlayers.emplace_back(GameSize::width(), GameSize::height());
+        Player& player = startPlayers[id];
+        player.id          = id;
+        player.orientation = fromPlayerId(id);
+        player.bIsAlive    = true;
+        player.wallsLeft   = 6;
+        player.coords      = Coords{ aRandom() % GameSize::width(), aRandom() % GameSize::height() };
+    }
+    for (size_t attempt = 0; (attempt < 100) && (startWalls.size() < 10); ++attempt) {
+        const Wall wall{ Coords{ aRandom() % GameSize::width(), aRandom() % GameSize::height() },
+                         (0 == aRandom() % 2) ? 'H' : 'V' };
+        if (Position(startPlayers, startWalls, 0).isLegal(wall)) {
+            startWalls.push_back(wall);
+        }
+    }
+
+    const Position              start(startPlayers, startWalls, 0);
+    Position                    position = start;
+    Player::Vector              players = startPlayers;
+    Wall::Vector                walls = startWalls;
+    std::vector<Position::Move> moves;
+    for (size_t idx = 0; idx < Moves; ++idx) {
+        const Position::Move move = randomMove(position, aRandom);
+        play(move, position.playerToMove(), players, walls);
+        position.make(move);
+        if (!isEqual(position, Position(players, walls, position.playerToMove()), aPlayerCount)) {
+            throw std::logic_error("Position: make differs from scratch");
+        }
+        moves.push_back(move);
+    }
+    for (size_t idx = Moves; idx > 0; --idx) {
+        position.unmake(moves[idx - 1]);
+    }
+    if (!isEqual(position, start, aPlayerCount)) {
+        throw std::logic_error("Position: unmake differs from the start");
+    }
+    return Game{ startPlayers, startWalls, moves, start };
+}
+
+/**
+ * Measure a workload on all the games: best time of the runs, per operation
+ *
+ * @param[in]  apWorkload   Name of the workload
+ * @param[in]  aOperations  Nb of operations of the workload on one game
+ * @param[in]  aGames       Random games
+ * @param[in]  aWorkload    Function object running the workload on one game
+ */
+template <class TWorkload>
+void measure(const char* apWorkload, const size_t aOperations, const std::vector<Game>& aGames, TWorkload aWorkload) {
+    const double bestDuration = bestOfRuns([&] {
+        for (size_t repeat = 0; repeat < Repeats; ++repeat) {
+            for (const auto& game : aGames) {
+                gSink = gSink + aWorkload(game);
+            }
+        }
+    });
+    std::cout << std::left << std::setw(18) << apWorkload << std::right;
+    printNsPerOp(bestDuration, Repeats * Positions * aOperations);
+    std::cout << std::endl;
+}
+
+/**
+ * Compare the copies of the Position and of the players and walls of a turn, and make()/unmake(), on random games
+ *
+ * @return 0
+ */
+int main() {
+    const MuteDebug     muteDebug;
+    std::mt19937        random(25);
+    std::vector<Game>   games;
+    for (size_t idx = 0; idx < Positions; ++idx) {
+        games.push_back(randomGame(2 + idx % 3, random));
+    }
+
+    std::cout << "sizeof(Position): " << sizeof(Position) << " bytes\n";
+    std::cout << "workload              ns/op\n";
+    measure("copy turn", 1, games, [](const Game& aGame) {
+        const Player::Vector players = aGame.players;
+        const Wall::Vector walls = aGame.walls;
+        return players.size() + walls.size();
+    });
+    measure("copy position", 1, games, [](const Game& aGame) {
+        const Position copy = aGame.position;
+        return static_cast<size_t>(copy.hash());
+    });
+    measure("make+unmake", Moves, games, [](const Game& aGame) {
+        Position position = aGame.position;
+        for (const auto& move : aGame.moves) {
+            position.make(move);
+        }
+        for (size_t idx = Moves; idx > 0; --idx) {
+            position.unmake(aGame.moves[idx - 1]);
+        }
+        return static_cast<size_t>(position.hash());
+    });
+
+    return 0;
+}
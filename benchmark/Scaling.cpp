@@ -0,0 +1,166 @@
+/**
+ * @file    Scaling.cpp
+ * @brief   Benchmark of the per-turn cost of the engine for board sizes from 9x9 up to 64x64.
+ *
+ *  Built once per size (see CMakeLists.txt), each binary measuring the size its bitboards are sized for:
+ * a board of 9x9 is then measured with the bitboards of the game, not with the ones of a 64x64 board.
+ *
+ * Copyright (c) 2015 Sebastien Rombauts (sebastien.rombauts@gmail.com, http://srombauts.github.io)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#define THEGREATESCAPE_BENCHMARK
+#include "Main.cpp" // NOLINT(build/include)
+#include "Measure.h"
+
+#include <random>
+
+/// Nb of random games for each size of board
+static const size_t Games = 20;
+/// Nb of times each turn is played (for a measurable duration)
+static const size_t Repeats = 10;
+
+/**
+ * Set up a random mid-game turn: players spread over the board, walls compatible and never blocking any player
+ *
+ * @param[in]  aWidthX      Nb of columns (X coordinate)
+ * @param[in]  aHeightY     Nb of lines   (Y coordinate)
+ * @param[in]  aPlayerCount Nb of players (2 to 4), all alive
+ * @param[in]  aRandom      Random generator
+ * @param[out] aPlayers     Players of the game, the last one being myself
+ * @param[out] aWalls       Walls of the board
+ */
+void randomTurn(const size_t aWidthX, const size_t aHeightY, const size_t aPlayerCount, std::mt19937& aRandom,
+                Player::Vector& aPlayers, Wall::Vector& aWalls) {
+    const Board empty(aWidthX, aHeightY);
+    aPlayers.clear();
+    aPlayers.reserve(aPlayerCount); // constructed in place, to keep the capacity of their working buffers
+    for (size_t id = 0; id < aPlayerCount; ++id) {
+        aPlayers.emplace_back(aWidthX, aHeightY);
+        Player& player = aPlayers[id];
+        player.id          = id;
+        player.orientation = fromPlayerId(id);
+        player.bIsAlive    = true;
+        player.bIsMySelf   = (id == aPlayerCount - 1);
+        player.order       = (id + 1) % aPlayerCount; // it is my turn
+        player.wallsLeft   = 10;
+        // somewhere on the board, at least one move away from the goal side
+        do {
+            player.coords = Coords{ aRandom() % aWidthX, aRandom() % aHeightY };
+        } while (0 == empty.heuristic(player.coords, player.orientation));
+    }
+
+    // about 3 walls for each column and line, as in the end of a game of 3 players on a 9x9 board
+    const size_t wallCount = 3 * (aWidthX + aHeightY) / 2;
+    Board board(aWidthX, aHeightY);
+    LegalWalls legalWalls(aWidthX, aHeightY);
+    aWalls.clear();
+    for (size_t attempt = 0; (attempt < 100 * wallCount) && (aWalls.size() < wallCount); ++attempt) {
+        const Wall wall{ Coords{ aRandom() % aWidthX, aRandom() % aHeightY }, (0 == aRandom() % 2) ? 'H' : 'V' };
+        if (legalWalls.isLegal(wall)) {
+            bool bIsValid = true;
+            board.addWall(wall, true);
+            for (const auto& player : aPlayers) {
+                bIsValid &= board.isReachable(player.coords, player.orientation);
+            }
+            if (bIsValid) {
+                aWalls.push_back(wall);
+                legalWalls.addWall(wall);
+            } else {
+                board.addWall(wall, false);
+            }
+        }
+    }
+}
+
+/**
+ * Play the work of one turn of main(): pathfinding of each player, then search of the best wall
+ *
+ * @param[in,out] aState    State of the game, with the walls of the board
+ * @param[in]     aPlayers  Players of the game, the last one being myself
+ *
+ * @return Nb of candidate walls evaluated (of the shortest path DAG of the first player)
+ */
+size_t playTurn(GameState& aState, Player::Vector& aPlayers) {
+    Board& board = aState.board;
+    board = Board(board.width(), board.height());
+    aState.legalWalls = LegalWalls(board.width(), board.height());
+    for (const auto& wall : aState.walls) {
+        board.addWall(wall);
+        aState.legalWalls.addWall(wall);
+    }
+    for (auto& player : aPlayers) {
+        player.paths.init(Cell{ Cell::Unreachable, eNone });
+        board.findShortest(player.paths, player.orientation);
+        player.distance = player.paths.get(player.coords).distance;
+    }
+    Player::VectorPtr& rankedPlayers = aState.rankedPlayers;
+    rankedPlayers.clear();
+    for (auto& player : aPlayers) {
+        rankedPlayers.push_back(&player);
+    }
+    std::sort(rankedPlayers.begin(), rankedPlayers.end(), Player::compare);
+    for (size_t rank = 0; rank < rankedPlayers.size(); rank++) {
+        rankedPlayers[rank]->rank = rank;
+    }
+
+    // always search for a wall against the first other player, as the worst case of a turn
+    const Player& firstPlayer = *rankedPlayers[rankedPlayers[0]->bIsMySelf ? 1 : 0];
+    Evaluation          bestEval;
+    bestEval.bIsValid       = false;
+    bestEval.impactOnFirst  = 0;
+    bestEval.impactOnMySelf = 0;
+    bestEval.impactOnOther  = 0;
+    bestEval.bIsCritical    = false;
+    bestEval.pathOrder      = 0;
+    for (auto& player : aPlayers) {
+        player.detours.init(player.paths, board, player.coords);
+    }
+    aState.firstDag.init(firstPlayer.paths, board, firstPlayer.coords);
+    evalWalls(aState, aPlayers, bestEval);
+
+    return aState.firstDag.walls().size();
+}
+
+/**
+ * Per-turn cost for the sizes of board needing exactly the bitboards of this build (3 and 4 players)
+ *
+ * @return 0
+ */
+int main() {
+    const MuteDebug muteDebug;
+    std::cout << "max cells: " << BitBoard::Bits << " (" << BitBoard::Words << " words per bitboard)\n";
+    std::cout << "   size players walls candidates   us/turn\n";
+
+    for (const size_t size : {9, 12, 16, 24, 32, 48, 64}) {
+        for (const size_t playerCount : {3, 4}) {
+            if (((size * (size + 1) + 127) / 128) * 128 == BitBoard::Bits) { // with the padding line of the Board
+                std::mt19937    random(static_cast<std::mt19937::result_type>(size * 10 + playerCount));
+                Player::Vector  players;
+                GameState       state(size, size, playerCount);
+                size_t          wallCount = 0;
+                size_t          candidates = 0;
+                double          duration = 0.0;
+                for (size_t game = 0; game < Games; ++game) {
+                    randomTurn(size, size, playerCount, random, players, state.walls);
+                    wallCount += state.walls.size();
+                    Measure measure;
+                    measure.start();
+                    for (size_t repeat = 0; repeat < Repeats; ++repeat) {
+                        candidates += playTurn(state, players);
+                    }
+                    duration += measure.get();
+                }
+                std::cout << std::setw(4) << size << "x" << std::left << std::setw(2) << size << std::right
+                          << std::setw(8) << playerCount << std::setw(6) << wallCount / Games
+                          << std::setw(11) << candidates / (Games * Repeats)
+                          << std::setw(10) << std::fixed << std::setprecision(1)
+                          << 1000.0 * duration / static_cast<double>(Games * Repeats) << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -14,12 +14,26 @@
 #include <iomanip>
 #include <vector>
 #include <algorithm>
+#include <utility>
 #include <limits>
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
 #include <chrono> // NOLINT(build/c++11)
+#include <cstdlib>
+#include <new>
 
-/// Define directions
-enum EDirection {
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#ifndef THEGREATESCAPE_MAX_CELLS
+/// Max number of cells of the bitboards: the board and its padding line (9x9 for the game, 64x64 for research)
+#define THEGREATESCAPE_MAX_CELLS 128
+#endif
+
+/// Define directions (on a single byte, for the compact Cell of the matrices of pathfinding)
+enum EDirection : uint8_t {
     eNone,
     eRight,
     eLeft,
@@ -34,6 +48,7 @@ EDirection fromPlayerId(const size_t aId) {
     case 0: direction = eRight; break;
     case 1: direction = eLeft;  break;
     case 2: direction = eDown;  break;
+    case 3: direction = eUp;    break;
     default:
         throw std::logic_error("fromPlayerId: default");
     }
@@ -57,6 +72,9 @@ char toChar(const EDirection aDirection) {
 
 /// coordinates
 struct Coords {
+    /// Vector of coordinates
+    typedef std::vector<Coords> Vector;
+
     size_t x;   ///< x-coordinate (column)
     size_t y;   ///< y-coordinate (row/line)
 
@@ -95,7 +113,7 @@ struct Coords {
     }
 
     /// get next coordinates into the specified direction
-    Coords next(EDirection aDirection) {
+    Coords next(EDirection aDirection) const {
         switch (aDirection) {
         case eRight:
             return right();
@@ -184,38 +202,71 @@ public:
     }
 };
 
-/// wall collision data of a cell for the matrix of walls
+/// wall collision data of a cell, as seen from the bitboard of walls
 struct Collision {
     bool bRight;    ///< is there a wall on the right of this Cell
     bool bLeft;     ///< is there a wall on the left of this Cell
     bool bDown;     ///< is there a wall on the bottom of this Cell
     bool bUp;       ///< is there a wall on the top of this Cell
 
-    /// Debug dump (for the bellow generic templated Matrix::dump() method)
+    /// Debug dump (for the bellow Board::dump() method)
     void dump() const {
         std::cerr << (bLeft ? '<' : ' ') << (bDown ? 'v' : ' ')
                   << (bUp ? '^' : ' ') << (bRight ? '>' : ' ') << "|";
     }
 };
 
-/// data of a cell for the matrix of pathfinding
+static_assert(THEGREATESCAPE_MAX_CELLS <= 65535, "distances of the cells shall fit on 16 bits");
+
+/// Distance of a cell toward the destination: a single byte for the board of the game (less than the max cells)
+typedef std::conditional<(THEGREATESCAPE_MAX_CELLS <= 255), uint8_t, uint16_t>::type Distance;
+
+/// data of a cell for the matrix of pathfinding (2 bytes for the board of the game)
 struct Cell {
-    size_t      distance;   ///< distance toward the destination
+    static constexpr Distance Unreachable = std::numeric_limits<Distance>::max(); ///< no path to the destination
+
+    Distance    distance;   ///< distance toward the destination (Unreachable if no path)
     EDirection  direction;  ///< direction of the shortest/best path
 
     /// Debug dump (for the bellow generic templated Matrix::dump() method)
     void dump() const {
-        std::cerr << std::fixed << std::setprecision(1) << std::setw(2) << distance << " "
+        std::cerr << std::fixed << std::setprecision(1) << std::setw(2) << static_cast<size_t>(distance) << " "
                   << toChar(direction) << "|";
     }
 };
+constexpr Distance Cell::Unreachable;
+
+/// Access policy of the Matrix checking the coordinates: can throw std::out_of_range
+struct CheckedAccess {
+    /// index of the cell at [X, Y] into the row-major buffer of a matrix of the given size
+    static size_t index(const size_t aX, const size_t aY, const size_t aWidthX, const size_t aHeightY) {
+        if ((aX >= aWidthX) || (aY >= aHeightY)) {
+            throw std::out_of_range("Matrix: coordinates");
+        }
+        return aY * aWidthX + aX;
+    }
+};
+
+/// Access policy of the Matrix without any check of the coordinates
+struct UncheckedAccess {
+    /// index of the cell at [X, Y] into the row-major buffer of a matrix of the given size
+    static size_t index(const size_t aX, const size_t aY, const size_t aWidthX, const size_t /* aHeightY */) {
+        return aY * aWidthX + aX;
+    }
+};
+
+#ifdef NDEBUG
+typedef UncheckedAccess DefaultAccess;  ///< Release: no check of the coordinates
+#else
+typedef CheckedAccess   DefaultAccess;  ///< Debug: check the coordinates
+#endif
 
-/// templated 2D matrix of generic TElement
-template <typename TElement>
+/// templated 2D matrix of generic TElement, stored line after line into a single contiguous buffer (one allocation)
+template <typename TElement, class TAccess = DefaultAccess>
 class Matrix {
 public:
     /// Vector of matrices
-    typedef std::vector<Matrix<TElement>> Vector;
+    typedef std::vector<Matrix> Vector;
 
     /**
      * ctor allocating the matrix to the specified size (with default initialisation)
@@ -223,11 +274,10 @@ public:
      * @param aWidthX    Nb of columns (X coordinate)
      * @param aHeightY   Nb of lines   (Y coordinate)
      */
-    Matrix(const size_t aWidthX, const size_t aHeightY) {
-        mMatrix.resize(aWidthX);
-        for (auto& line : mMatrix) {
-            line.resize(aHeightY);
-        }
+    Matrix(const size_t aWidthX, const size_t aHeightY) :
+        mWidth(aWidthX),
+        mHeight(aHeightY),
+        mMatrix(aWidthX * aHeightY) {
     }
 
     /**
@@ -237,46 +287,41 @@ public:
      * @param aHeightY   Nb of lines   (Y coordinate)
      * @param aInitValue Initial Value of every elements
      */
-    Matrix(const size_t aWidthX, const size_t aHeightY, const TElement& aInitValue) {
-        mMatrix.resize(aWidthX);
-        for (auto& line : mMatrix) {
-            line.resize(aHeightY, aInitValue);
-        }
+    Matrix(const size_t aWidthX, const size_t aHeightY, const TElement& aInitValue) :
+        mWidth(aWidthX),
+        mHeight(aHeightY),
+        mMatrix(aWidthX * aHeightY, aInitValue) {
     }
 
-    /// Initialize all the matrix with the provided value
+    /// Initialize all the matrix with the provided value (bulk fill of the buffer)
     void init(const TElement& aInitValue) {
-        for (auto& line : mMatrix) {
-            for (auto& cell : line) {
-                cell = aInitValue;
-            }
-        }
+        std::fill(mMatrix.begin(), mMatrix.end(), aInitValue);
     }
 
     /// width of the matrix (Nb of columns, X axis)
     size_t width() const {
-        return mMatrix.size();
+        return mWidth;
     }
     /// height of the matrix (Nb of lines, Y axis)
     size_t height() const {
-        return mMatrix.at(0).size();
+        return mHeight;
     }
 
-    /// getter for cell at [X, Y] (const reference) uses vector::at() with safety check : can throw std::out_of_range
+    /// getter for cell at [X, Y] (const reference), checked by the TAccess policy: can throw std::out_of_range
     const TElement& get(const size_t aX, const size_t aY) const {
-        return mMatrix.at(aX).at(aY); // return mMatrix[aX][aY];
+        return mMatrix[TAccess::index(aX, aY, mWidth, mHeight)];
     }
-    /// getter for cell at [X, Y] (const reference) uses vector::at() with safety check : can throw std::out_of_range
+    /// getter for cell at [X, Y] (const reference), checked by the TAccess policy: can throw std::out_of_range
     const TElement& get(const Coords& aCoords) const {
-        return mMatrix.at(aCoords.x).at(aCoords.y);
+        return mMatrix[TAccess::index(aCoords.x, aCoords.y, mWidth, mHeight)];
     }
-    /// "setter" for cell at [X, Y] (reference) uses vector::at() with safety check : can throw std::out_of_range
+    /// "setter" for cell at [X, Y] (reference), checked by the TAccess policy: can throw std::out_of_range
     TElement& set(const size_t aX, const size_t aY) {
-        return mMatrix.at(aX).at(aY);
+        return mMatrix[TAccess::index(aX, aY, mWidth, mHeight)];
     }
-    /// "setter" for cell at [X, Y] (reference) uses vector::at() with safety check : can throw std::out_of_range
+    /// "setter" for cell at [X, Y] (reference), checked by the TAccess policy: can throw std::out_of_range
     TElement& set(const Coords& aCoords) {
-        return mMatrix.at(aCoords.x).at(aCoords.y);
+        return mMatrix[TAccess::index(aCoords.x, aCoords.y, mWidth, mHeight)];
     }
 
     /// debug: dump content of the Matrix of TElement, using a required TElement::dump() method
@@ -296,56 +341,9 @@ public:
     }
 
 private:
-    /// Vector of Elements
-    typedef std::vector<TElement>   Vector1D;
-    /// Matrix as a vector of vectors of Elements
-    typedef std::vector<Vector1D>   Vector2D;
-
-    /// TODO(SRombauts) try and compare performances (construction, copy, usage) with a 1D vector using math
-    ///                 Then compare with a std::array
-    Vector2D mMatrix;    ///< Matrix as a vector of vectors of Elements
-};
-
-/// player data
-struct Player {
-    /// Vector of players
-    typedef std::vector<Player> Vector;
-    /// Vector of pointers of players (for sorting by rank)
-    typedef std::vector<Player*> VectorPtr;
-
-    /// Init the Matrix
-    Player(const size_t aWidthX, const size_t aHeightY) :
-        paths(aWidthX, aHeightY),
-        id(0),
-        bIsMySelf(false),
-        orientation(eNone),
-        coords(),
-        wallsLeft(0),
-        distance(0),
-        order(0),
-        rank(0),
-        bIsAlive(false) {
-    }
-
-    Matrix<Cell>    paths;       ///< grid for pathfinding of the player
-    size_t          id;          ///< id of the player (implicit orientation)
-    bool            bIsMySelf;   ///< explicite shortcut for (id == myId) and/or (order == 0)
-    EDirection      orientation; ///< general direction of the path to exit (explicit orientation)
-    Coords          coords;      ///< coordinates of the player
-    size_t          wallsLeft;   ///< number of walls available for the player
-    size_t          distance;    ///< distance left to reach the destination
-    size_t          order;       ///< order of the player into the turn based on its id vs me (I am playing = order 0)
-    size_t          rank;        ///< rank based on the distance left and the order of the player
-    bool            bIsAlive;    ///< true while the player is alive
-
-    /// ranking of each player : distance left, and take into account the order of the player into the turn
-    static bool compare(const Player* apA, const Player* apB) {
-    if (apA->distance != apB->distance) {
-        return (apA->distance < apB->distance);
-    } else  {
-        return (apA->order < apB->order);
-    }
-}
+    size_t                  mWidth;     ///< Nb of columns (X axis)
+    size_t                  mHeight;    ///< Nb of lines (Y axis)
+    std::vector<TElement>   mMatrix;    ///< Elements line after line (row-major: index = y * width + x)
 };
 
 /// Time measure using C++11 std::chrono
@@ -366,345 +364,2573 @@ private:
     std::chrono::high_resolution_clock::time_point   mStartTime; ///< Store the first time measure
 };
 
-/// Recursive shortest path algorithm
-void findShortest(Matrix<Cell>& aOutPaths, const Matrix<Collision>& aCollisions, const EDirection aOrientation,
-    const Coords& aCoords, const size_t aDistance, const EDirection aDirection) {
-    // If the distance of this path is less than any preceding one on this cell
-    // In case of equal distance, go into the preferred direction (player orientation)
-    if ((aOutPaths.get(aCoords).distance > aDistance)
-        || ((aOutPaths.get(aCoords).distance == aDistance) && (aDirection == aOrientation))) {
-        // Update the cell
-        aOutPaths.set(aCoords).distance = aDistance;
-        aOutPaths.set(aCoords).direction = aDirection;
-
-        // Recurse into adjacent cells
-        if ((aCoords.x > 0) && (!aCollisions.get(aCoords).bLeft)) {
-            findShortest(aOutPaths, aCollisions, aOrientation, aCoords.left(), aDistance + 1, eRight);
-        }
-        if ((aCoords.x < aOutPaths.width() - 1) && (!aCollisions.get(aCoords).bRight)) {
-            findShortest(aOutPaths, aCollisions, aOrientation, aCoords.right(), aDistance + 1, eLeft);
+#ifdef THEGREATESCAPE_TRACK_ALLOCATIONS
+/**
+ * @brief Allocations made by each phase of a turn, counted by the global operator new and operator delete
+ *
+ *  Opt-in (build with THEGREATESCAPE_TRACK_ALLOCATIONS defined): each block then begins with a header keeping
+ * its size, so that the bytes in use, and their peak during each phase, are known.
+ * Zero-initialized (no ctor), so that it can count the allocations made before main().
+ */
+class Allocations {
+public:
+    /// Phases of a turn
+    enum EPhase {
+        eParse,         ///< read of the players and of the walls
+        ePathfinding,   ///< shortest paths of each player
+        eRanking,       ///< ranking of the players
+        eWalls,         ///< search of the best wall, and command
+        ePhases         ///< Nb of phases
+    };
+
+    static const size_t Header = 16;    ///< Size of the header of a block (keeping the alignment of malloc())
+
+    /// Reset the counters of all the phases, and start counting for the first one
+    void reset(const EPhase aPhase) {
+        for (auto& counters : mCounters) {
+            counters = Counters{ 0, 0, mInUse };
         }
-        if ((aCoords.y > 0) && (!aCollisions.get(aCoords).bUp)) {
-            findShortest(aOutPaths, aCollisions, aOrientation, aCoords.up(), aDistance + 1, eDown);
+        mPhase = aPhase;
+    }
+    /// Start counting for another phase
+    void start(const EPhase aPhase) {
+        mPhase = aPhase;
+        mCounters[mPhase].peak = std::max(mCounters[mPhase].peak, mInUse);
+    }
+
+    /// Count an allocation of the given size
+    void allocated(const size_t aSize) {
+        Counters& counters = mCounters[mPhase];
+        ++counters.count;
+        counters.bytes += aSize;
+        mInUse         += aSize;
+        counters.peak   = std::max(counters.peak, mInUse);
+    }
+    /// Count the release of a block of the given size
+    void freed(const size_t aSize) {
+        mInUse -= aSize;
+    }
+
+    /// Nb of allocations since the last reset
+    size_t count() const {
+        size_t count = 0;
+        for (const auto& counters : mCounters) {
+            count += counters.count;
         }
-        if ((aCoords.y < aOutPaths.height() - 1) && (!aCollisions.get(aCoords).bDown)) {
-            findShortest(aOutPaths, aCollisions, aOrientation, aCoords.down(), aDistance + 1, eUp);
+        return count;
+    }
+
+    /// Debug dump of the counters of each phase
+    void dump() const {
+        static const char* const names[ePhases] = { "parse", "pathfinding", "ranking", "walls" };
+        std::cerr << "allocations:";
+        for (size_t phase = 0; phase < ePhases; ++phase) {
+            std::cerr << " " << names[phase] << " " << mCounters[phase].count << " (" << mCounters[phase].bytes
+                      << " bytes, peak " << mCounters[phase].peak << ")";
         }
+        std::cerr << std::endl;
+    }
+
+private:
+    /// Counters of a phase
+    struct Counters {
+        size_t  count;  ///< Nb of allocations
+        size_t  bytes;  ///< Nb of bytes allocated
+        size_t  peak;   ///< Max number of bytes in use
+    };
+
+    EPhase      mPhase;                 ///< Current phase
+    Counters    mCounters[ePhases];     ///< Counters of each phase
+    size_t      mInUse;                 ///< Nb of bytes in use
+};
+
+/// Allocations of each phase of the turn
+Allocations gAllocations;
+
+/// Counting allocation: the block begins with a header keeping its size
+void* operator new(size_t aSize) {
+    void* pBlock = std::malloc(Allocations::Header + aSize);
+    if (nullptr == pBlock) {
+        throw std::bad_alloc();
     }
+    *static_cast<size_t*>(pBlock) = aSize;
+    gAllocations.allocated(aSize);
+    return static_cast<char*>(pBlock) + Allocations::Header;
 }
-/// Shortest path algorithm
-void findShortest(Matrix<Cell>& aOutPaths, const Matrix<Collision>& aCollisions, const EDirection aOrientation) {
-    size_t x;
-    size_t y;
-
-    switch (aOrientation) {
-    case eRight:
-        x = 8;
-        for (y = 0; y < aOutPaths.height(); ++y) {
-            findShortest(aOutPaths, aCollisions, aOrientation, Coords{ x, y }, 0, eNone);
-        }
-        break;
-    case eLeft:
-        x = 0;
-        for (y = 0; y < aOutPaths.height(); ++y) {
-            findShortest(aOutPaths, aCollisions, aOrientation, Coords{ x, y }, 0, eNone);
-        }
-        break;
-    case eDown:
-        y = 8;
-        for (x = 0; x < aOutPaths.width(); ++x) {
-            findShortest(aOutPaths, aCollisions, aOrientation, Coords{ x, y }, 0, eNone);
-        }
-        break;
-    case eUp:
-    case eNone:
-    default:
-        throw std::logic_error("shortest: default");
-        break;
+/// Counting release, of a block allocated by the above operator new
+void operator delete(void* apBlock) noexcept {
+    if (nullptr != apBlock) {
+        // by address: GCC checks an index before the object of the caller as out of its bounds (-Warray-bounds)
+        void* pBlock = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(apBlock) - Allocations::Header);
+        gAllocations.freed(*static_cast<size_t*>(pBlock));
+        std::free(pBlock);
     }
 }
-
-/// Set a wall into the collision matrix
-void addWallCollisions(Matrix<Collision>& aOutCollisions, const Wall& aWall, const bool abValue = true) {
-    if (aWall.orientation == 'H') { // 'H' --
-        // x,y-1 x+1,y-1
-        // x,y   x+1,y
-        aOutCollisions.set(aWall.coords.up())     .bDown = abValue;
-        aOutCollisions.set(aWall.coords.upright()).bDown = abValue;
-        aOutCollisions.set(aWall.coords)          .bUp   = abValue;
-        aOutCollisions.set(aWall.coords.right())  .bUp   = abValue;
-    } else { // .orientation == 'V'
-        // x-1,y   x,y
-        // x-1,y-1 x,y-1
-        aOutCollisions.set(aWall.coords.left()).bRight     = abValue;
-        aOutCollisions.set(aWall.coords.downleft()).bRight = abValue;
-        aOutCollisions.set(aWall.coords).bLeft             = abValue;
-        aOutCollisions.set(aWall.coords.down()).bLeft      = abValue;
+/// Counting allocation of an array
+void* operator new[](size_t aSize) {
+    return operator new(aSize);
+}
+/// Counting release of an array
+void operator delete[](void* apBlock) noexcept {
+    operator delete(apBlock);
+}
+/// Counting allocation, returning nullptr on failure
+void* operator new(size_t aSize, const std::nothrow_t&) noexcept {
+    void* pBlock = nullptr;
+    try {
+        pBlock = operator new(aSize);
+    } catch (const std::bad_alloc&) {
+        pBlock = nullptr;
     }
+    return pBlock;
 }
+/// Counting allocation of an array, returning nullptr on failure
+void* operator new[](size_t aSize, const std::nothrow_t& aNothrow) noexcept {
+    return operator new(aSize, aNothrow);
+}
+/// Counting release, of a block allocated by the above nothrow operator new
+void operator delete(void* apBlock, const std::nothrow_t&) noexcept {
+    operator delete(apBlock);
+}
+/// Counting release, of an array allocated by the above nothrow operator new[]
+void operator delete[](void* apBlock, const std::nothrow_t&) noexcept {
+    operator delete(apBlock);
+}
+#else // THEGREATESCAPE_TRACK_ALLOCATIONS
+/// Allocations not tracked: the phases of a turn are ignored, so that the calls compile to nothing
+class Allocations {
+public:
+    /// Phases of a turn
+    enum EPhase {
+        eParse,         ///< read of the players and of the walls
+        ePathfinding,   ///< shortest paths of each player
+        eRanking,       ///< ranking of the players
+        eWalls          ///< search of the best wall, and command
+    };
+
+    /// Nothing to reset
+    void reset(const EPhase) {
+    }
+    /// Nothing to count
+    void start(const EPhase) {
+    }
+};
 
-
-/// Test compatibility of a new wall against a wall already on the board
-bool isCompatible(const Wall& aExistingWall, const Wall& aNewWall) {
-    bool bIsCompatible = true;
-    if (aExistingWall.orientation == 'H') {
-        if        ((aNewWall.orientation == 'H')
-               &&    ((aExistingWall.coords.left()  == aNewWall.coords)
-                   || (aExistingWall.coords         == aNewWall.coords)
-                   || (aExistingWall.coords.right() == aNewWall.coords))) {
-            bIsCompatible = false;
-        } else if ((aNewWall.orientation == 'V') && (aExistingWall.coords.upright() == aNewWall.coords)) {
-            bIsCompatible = false;
-        }
-    } else { // gWall.orientation == 'V'
-        if        ((aNewWall.orientation == 'V')
-               &&   ((aExistingWall.coords.up()     == aNewWall.coords)
-                  || (aExistingWall.coords          == aNewWall.coords)
-                  || (aExistingWall.coords.down()   == aNewWall.coords))) {
-            bIsCompatible = false;
-        } else if ((aNewWall.orientation == 'H') && ((aExistingWall.coords.downleft() == aNewWall.coords))) { // 'V'
-            bIsCompatible = false;
-        }
-    }
-    return bIsCompatible;
+/// Allocations of each phase of the turn, not tracked
+Allocations gAllocations;
+#endif // THEGREATESCAPE_TRACK_ALLOCATIONS
+
+/// Index of the least significant bit set in a non-zero 64 bits word
+size_t countTrailingZeros(const uint64_t aWord) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, aWord);
+    return static_cast<size_t>(index);
+#else
+    return static_cast<size_t>(__builtin_ctzll(aWord));
+#endif
 }
 
-/// Test compatibility of a new wall based solely on coordinates
-bool isCompatible(const size_t aWidthX, const size_t aHeightY, const Wall& aWall) {
-    bool bIsCompatible = true;
-    if (aWall.orientation == 'H') {
-        if ((aWall.coords.x >= aWidthX - 1) || (aWall.coords.y == 0) || (aWall.coords.y > aHeightY)) {
-            bIsCompatible = false;
+/// Pack of the indexes [0; N-1] to expand into constexpr arrays (std::index_sequence is C++14)
+template <size_t... TIndexes>
+struct Indexes {
+};
+/// Build the pack Indexes<0, 1, ..., TCount - 1>
+template <size_t TCount, size_t... TIndexes>
+struct MakeIndexes : MakeIndexes<TCount - 1, TCount - 1, TIndexes...> {
+};
+/// End of the recursion of MakeIndexes
+template <size_t... TIndexes>
+struct MakeIndexes<0, TIndexes...> {
+    typedef Indexes<TIndexes...> Type; ///< the pack of indexes
+};
+
+/// Set of up to THEGREATESCAPE_MAX_CELLS cells of the board, one bit per cell (see Board::index())
+struct BitBoard {
+    static const size_t Bits  = ((THEGREATESCAPE_MAX_CELLS + 127) / 128) * 128; ///< Max number of cells
+    static const size_t Words = Bits / 64;                                      ///< Nb of 64 bits words
+
+    uint64_t words[Words];  ///< bits of the cells [64 * i; 64 * i + 63] in the word i
+
+    /// set of the single cell at the given index
+    static constexpr BitBoard bit(const size_t aIndex) {
+        return bit(aIndex, MakeIndexes<Words>::Type());
+    }
+    /// union of two sets, usable to build constexpr tables
+    static constexpr BitBoard unite(const BitBoard& aLeft, const BitBoard& aRight) {
+        return unite(aLeft, aRight, MakeIndexes<Words>::Type());
+    }
+
+    /// test the bit of the cell at the given index
+    bool test(const size_t aIndex) const {
+        return (0 != ((words[aIndex / 64] >> (aIndex % 64)) & 1));
+    }
+    /// set the bit of the cell at the given index
+    void set(const size_t aIndex) {
+        words[aIndex / 64] |= (uint64_t(1) << (aIndex % 64));
+    }
+    /// reset the bit of the cell at the given index
+    void reset(const size_t aIndex) {
+        words[aIndex / 64] &= ~(uint64_t(1) << (aIndex % 64));
+    }
+    /// is there any bit set
+    bool any() const {
+        uint64_t bits = 0;
+        for (size_t word = 0; word < Words; ++word) {
+            bits |= words[word];
         }
-    } else { // .orientation == 'V'
-        if ((aWall.coords.y >= aHeightY - 1) || (aWall.coords.x == 0) || (aWall.coords.x > aWidthX)) {
-            bIsCompatible = false;
+        return (0 != bits);
+    }
+    /// get the index of the first bit set, and reset it (the BitBoard shall not be empty)
+    size_t pop() {
+        size_t index = Bits;
+        for (size_t word = 0; word < Words; ++word) { // constant trip count, to keep the words into registers
+            if ((index == Bits) && (0 != words[word])) {
+                index = 64 * word + countTrailingZeros(words[word]);
+                words[word] &= (words[word] - 1);
+            }
         }
+        return index;
     }
-    // std::cerr << "isCompatible()=" << bIsCompatible << std::endl;
-    return bIsCompatible;
-}
 
-/// Test compatibility of a new wall against all walls already on the board
-bool isCompatible(const size_t aWidthX, const size_t aHeightY, const Wall::Vector& aExistingWalls, const Wall& aWall) {
-    bool bIsCompatible = isCompatible(aWidthX, aHeightY, aWall);
-    if (bIsCompatible) {
-        Wall::Vector::const_iterator iWall = aExistingWalls.begin();
-        while ((iWall != aExistingWalls.end()) && (bIsCompatible == true)) {
-            bIsCompatible = isCompatible(*iWall, aWall);
-            ++iWall;
+    /// intersection of two sets
+    BitBoard operator& (const BitBoard& aBitBoard) const {
+        BitBoard result;
+        for (size_t word = 0; word < Words; ++word) {
+            result.words[word] = words[word] & aBitBoard.words[word];
         }
-        std::cerr << "isCompatible([" << aWall.coords << "] " << aWall.orientation << ")="
-            << bIsCompatible << std::endl;
+        return result;
     }
-    return bIsCompatible;
-}
-
-/// Evaluation of impacts of the placement of a wall
-struct Evaluation {
-    bool    bIsValid;       ///< Does this structure represent a valide result (no player blocked)
-    Wall    wall;           ///< Wall to evaluate
-    size_t  impactOnFirst;  ///< Increase of distance on the shortest path of the first player [O:
-    size_t  impactOnMySelf; ///< Increase of distance on the shortest path of myself
-    size_t  impactOnOther;  ///< Increase of distance on the shortest path of the other player if any
-
-    /// evaluation of the best result to keep (equal is to keep the LAST best eval, ie next to the exit
-    bool operator<= (const Evaluation& aEvaluation) {
-        return (((100.f*impactOnFirst)-(70.f*impactOnMySelf)+(40.f*impactOnOther))
-            <= ((100.f*aEvaluation.impactOnFirst)-(70.f*aEvaluation.impactOnMySelf)+(40.f*aEvaluation.impactOnOther)));
+    /// union of two sets
+    BitBoard operator| (const BitBoard& aBitBoard) const {
+        BitBoard result;
+        for (size_t word = 0; word < Words; ++word) {
+            result.words[word] = words[word] | aBitBoard.words[word];
+        }
+        return result;
     }
-};
-
-/// Evaluation of all impacts of a wall
-void evalWall(Matrix<Cell>& aPaths, Matrix<Collision>& aCollisions,
-              const Player::Vector& aPlayers, const Wall::Vector& aExistingWalls,
-              const Wall& aWall, Evaluation& aBestEval) {
-    bool bIsCompatible = isCompatible(aPaths.width(), aPaths.height(), aExistingWalls, aWall);
-    if (bIsCompatible) {
-        Evaluation eval;
-        eval.bIsValid       = true;
-        eval.impactOnFirst  = 0;
-        eval.impactOnMySelf = 0;
-        eval.impactOnOther  = 0;
-
-        addWallCollisions(aCollisions, aWall, true);    // set
-
-        for (const auto& player : aPlayers) {
-            if (player.bIsAlive) {
-                aPaths.init(Cell{std::numeric_limits<size_t>::max(), eNone});
-                findShortest(aPaths, aCollisions, player.orientation);
-                const size_t nextDistance = aPaths.get(player.coords).distance;
-                if (nextDistance < std::numeric_limits<size_t>::max()) {
-                    std::cerr << "nextDistance(" << player.id << " [" << player.coords << "])="
-                              << nextDistance << std::endl;
-                    if (player.rank == 0) {
-                        eval.impactOnFirst    = (nextDistance - player.distance);
-                        std::cerr << "impactOnFirst(" << nextDistance << "-" << player.distance
-                                  << ")=" << eval.impactOnFirst << std::endl;
-                    } else if (player.bIsMySelf) {
-                        eval.impactOnMySelf   = (nextDistance - player.distance);
-                        std::cerr << "impactOnMySelf(" << nextDistance << "-" << player.distance
-                            << ")=" << eval.impactOnMySelf << std::endl;
-                    } else {
-                        eval.impactOnOther    = (nextDistance - player.distance);
-                        std::cerr << "impactOnOther(" << nextDistance << "-" << player.distance
-                            << ")=" << eval.impactOnOther << std::endl;
-                    }
-                } else {
-                    eval.bIsValid = false;
-                    break;
+    /// complement of the set
+    BitBoard operator~ () const {
+        BitBoard result;
+        for (size_t word = 0; word < Words; ++word) {
+            result.words[word] = ~words[word];
+        }
+        return result;
+    }
+    /// shift toward the higher indexes (0 < aShift < Bits)
+    BitBoard operator<< (const size_t aShift) const {
+        const size_t offset = aShift / 64;  // whole words
+        const size_t shift  = aShift % 64;  // remaining bits
+        BitBoard result;
+        for (size_t word = 0; word < Words; ++word) {
+            uint64_t bits = 0;
+            if (word >= offset) {
+                bits = words[word - offset] << shift;
+                if ((shift > 0) && (word > offset)) {
+                    bits |= words[word - offset - 1] >> (64 - shift);
                 }
             }
+            result.words[word] = bits;
         }
-        // evaluation of the result to keep the best (keep the last one, ie near the exit)
-        if ((eval.bIsValid) && (eval.impactOnFirst > 0) && ((aBestEval <= eval) || (!aBestEval.bIsValid))) {
-            std::cerr << "new best[" << aWall.coords << "] " << aWall.orientation
-                << " (" << eval.impactOnFirst << ";" << eval.impactOnMySelf << ";" << eval.impactOnOther << ")\n";
-            eval.wall = aWall;
-            aBestEval = eval;
-            std::cerr << "new best[" << aBestEval.wall.coords << "] " << aBestEval.wall.orientation << "\n";
-            std::cerr << "new best(" << aBestEval.impactOnFirst << ";" << aBestEval.impactOnMySelf
-                << ";" << aBestEval.impactOnOther << ")\n";
+        return result;
+    }
+    /// shift toward the lower indexes (0 < aShift < Bits)
+    BitBoard operator>> (const size_t aShift) const {
+        const size_t offset = aShift / 64;  // whole words
+        const size_t shift  = aShift % 64;  // remaining bits
+        BitBoard result;
+        for (size_t word = 0; word < Words; ++word) {
+            uint64_t bits = 0;
+            if (word + offset < Words) {
+                bits = words[word + offset] >> shift;
+                if ((shift > 0) && (word + offset + 1 < Words)) {
+                    bits |= words[word + offset + 1] << (64 - shift);
+                }
+            }
+            result.words[word] = bits;
         }
-
-        addWallCollisions(aCollisions, aWall, false);   // reset
+        return result;
+    }
+    /// intersection with another set
+    BitBoard& operator&= (const BitBoard& aBitBoard) {
+        for (size_t word = 0; word < Words; ++word) {
+            words[word] &= aBitBoard.words[word];
+        }
+        return *this;
+    }
+    /// union with another set
+    BitBoard& operator|= (const BitBoard& aBitBoard) {
+        for (size_t word = 0; word < Words; ++word) {
+            words[word] |= aBitBoard.words[word];
+        }
+        return *this;
     }
-}
 
+private:
+    /// set of the single cell at the given index, expanded word by word
+    template <size_t... TIndexes>
+    static constexpr BitBoard bit(const size_t aIndex, Indexes<TIndexes...>) {
+        return BitBoard{ { ((aIndex / 64 == TIndexes) ? (uint64_t(1) << (aIndex % 64)) : uint64_t(0))... } };
+    }
+    /// union of two sets, expanded word by word
+    template <size_t... TIndexes>
+    static constexpr BitBoard unite(const BitBoard& aLeft, const BitBoard& aRight, Indexes<TIndexes...>) {
+        return BitBoard{ { (aLeft.words[TIndexes] | aRight.words[TIndexes])... } };
+    }
+};
 
 /**
- * Auto-generated code below aims at helping you parse
- * the standard input according to the problem statement.
+ * @brief Slots of the walls: one bit per slot, indexed as the cells of the Board (y * width + x), by orientation
  *
- * @return 0
+ *  The rules of the walls only depend on the coordinates of their slots, so these functions are constexpr:
+ * for the size of the game, the slots inside the board, the edges blocked by each wall and the slots of the walls
+ * incompatible with it are tables computed at compile time (see WallTable).
  */
-int main() {
-    size_t w; // width of the board
-    size_t h; // height of the board
-    size_t playerCount; // number of players (2 or 3)
-    size_t myId; // id of my player (0 = 1st player, 1 = 2nd player, ...)
-    std::cin >> w >> h >> playerCount >> myId; std::cin.ignore();
+struct WallSlots {
+    BitBoard    slots[2];   ///< slots of the horizontal walls, then of the vertical walls
 
-    // all players statuses
-    Player::Vector players(playerCount, Player(w, h));
-    Player& mySelf = players[myId];
-    mySelf.bIsMySelf = true;
-    Measure measure;
-    bool bModeWall = false; // memory to keep putting walls after the first one
-
-    // game loop
-    for (size_t turn = 0; turn < 100; ++turn) {
-        // wait and read players data
-        for (size_t id = 0; id < playerCount; ++id) {
-            Player& player = players[id];
+    /// index of the set of slots of an orientation
+    static constexpr size_t side(const char aOrientation) {
+        return (aOrientation == 'H') ? 0 : 1;
+    }
 
-            int x; // x-coordinate of the player
-            int y; // y-coordinate of the player
-            size_t wallsLeft; // number of walls available for the player
-            std::cin >> x >> y >> wallsLeft; std::cin.ignore();
+    /// Is the slot of a wall inside the board, blocking two edges inside it (a coordinate wrapped below 0 is outside)
+    static constexpr bool isInside(const char aOrientation, const size_t aX, const size_t aY,
+                                   const size_t aWidthX, const size_t aHeightY) {
+        return (aOrientation == 'H') ? ((aX < aWidthX - 1) && (aY > 0) && (aY < aHeightY))
+                                     : ((aY < aHeightY - 1) && (aX > 0) && (aX < aWidthX));
+    }
 
-            player.id          = id;               // redundant with the index, but useful
-            player.orientation = fromPlayerId(id); // redundant with the id, but useful
-            player.wallsLeft   = wallsLeft;
+    /// Pair of edges blocked by the wall at the given index (see Board::addWall()): moves up 'H', moves left 'V'
+    static constexpr BitBoard edges(const char aOrientation, const size_t aIndex, const size_t aWidthX) {
+        return BitBoard::unite(BitBoard::bit(aIndex), BitBoard::bit(aIndex + ((aOrientation == 'H') ? 1 : aWidthX)));
+    }
 
-            // if player still playing
-            if ((x >= 0) && (y >= 0)) {
-                player.coords.x = static_cast<size_t>(x);
-                player.coords.y = static_cast<size_t>(y);
-                player.bIsAlive = true;
-
-                /* debug:
-                if (player.bIsMySelf) {
-                    std::cerr << "myself(" << player.id << "): [" << player.coords.x
-                              << ", " << player.coords.y << "] (wallsLeft=" << player.wallsLeft << ")\n";
-                } else {
-                    std::cerr << "player(" << player.id << "): [" << player.coords.x
-                              << ", " << player.coords.y << "] (wallsLeft=" << player.wallsLeft << ")\n";
-                }
-                */
-            } else {
-                player.bIsAlive = false;
-                std::cerr << "_dead_(" << id << "): [" << x << ", " << y << "]\n";
-            }
-        }
+    /// Slots of the walls incompatible with a wall, its own slot included: overlapping it, or crossing it
+    static constexpr WallSlots conflicts(const char aOrientation, const size_t aX, const size_t aY,
+                                         const size_t aWidthX, const size_t aHeightY) {
+        return (aOrientation == 'H')
+            ? WallSlots{ { BitBoard::unite(slot(aX - 1, aY, aWidthX, aHeightY),   // left
+                           BitBoard::unite(slot(aX, aY, aWidthX, aHeightY),        // self
+                                           slot(aX + 1, aY, aWidthX, aHeightY))),  // right
+                           slot(aX + 1, aY - 1, aWidthX, aHeightY) } }             // upright
+            : WallSlots{ { slot(aX - 1, aY + 1, aWidthX, aHeightY),                // downleft
+                           BitBoard::unite(slot(aX, aY - 1, aWidthX, aHeightY),    // up
+                           BitBoard::unite(slot(aX, aY, aWidthX, aHeightY),        // self
+                                           slot(aX, aY + 1, aWidthX, aHeightY))) } }; // down
+    }
 
-        // read walls data
-        size_t wallCount; // number of walls on the board
-        std::cin >> wallCount; std::cin.ignore();
+private:
+    /// single slot at [X, Y], or none outside of the board (the coordinates of the neighbors can wrap around)
+    static constexpr BitBoard slot(const size_t aX, const size_t aY, const size_t aWidthX, const size_t aHeightY) {
+        return ((aX < aWidthX) && (aY < aHeightY)) ? BitBoard::bit(aY * aWidthX + aX) : BitBoard{};
+    }
+};
 
-        Wall::Vector        walls(wallCount);
-        Matrix<Collision>   collisions(w, h);
-        for (auto& wall : walls) {
-            std::cin >> wall.coords.x >> wall.coords.y >> wall.orientation; std::cin.ignore();
-            /* std::cerr << "wall[" << wall.coords << "] '"
-                      << wall.orientation <<"'\n"; */
-            addWallCollisions(collisions, wall);
-        }
+/// Tables of the walls of a board of a size known at compile time, by orientation and slot (see WallSlots)
+template <size_t TWidth, size_t THeight, class TIndexes = typename MakeIndexes<TWidth * THeight>::Type>
+struct WallTable;
+/// Tables expanded over the pack of the indexes of the slots
+template <size_t TWidth, size_t THeight, size_t... TIndexes>
+struct WallTable<TWidth, THeight, Indexes<TIndexes...>> {
+private:
+    /// slots of the given orientation inside the board, from the given index to the last one
+    static constexpr BitBoard inside(const char aOrientation, const size_t aIndex = 0) {
+        return (aIndex < TWidth * THeight)
+            ? BitBoard::unite(WallSlots::isInside(aOrientation, aIndex % TWidth, aIndex / TWidth, TWidth, THeight)
+                                  ? BitBoard::bit(aIndex) : BitBoard{},
+                              inside(aOrientation, aIndex + 1))
+            : BitBoard{};
+    }
 
-        // Start-counting the time after the input are all read
-        measure.start();
+public:
+    static constexpr WallSlots Inside = { { inside('H'), inside('V') } }; ///< slots inside the empty board
+    static constexpr BitBoard Edges[2][TWidth * THeight] = {
+        { WallSlots::edges('H', TIndexes, TWidth)... },
+        { WallSlots::edges('V', TIndexes, TWidth)... } };                  ///< edges blocked, by orientation and slot
+    static constexpr WallSlots Conflicts[2][TWidth * THeight] = {
+        { WallSlots::conflicts('H', TIndexes % TWidth, TIndexes / TWidth, TWidth, THeight)... },
+        { WallSlots::conflicts('V', TIndexes % TWidth, TIndexes / TWidth, TWidth, THeight)... } }; ///< by slot
+};
+template <size_t TWidth, size_t THeight, size_t... TIndexes>
+constexpr WallSlots WallTable<TWidth, THeight, Indexes<TIndexes...>>::Inside;
+template <size_t TWidth, size_t THeight, size_t... TIndexes>
+constexpr BitBoard WallTable<TWidth, THeight, Indexes<TIndexes...>>::Edges[2][TWidth * THeight];
+template <size_t TWidth, size_t THeight, size_t... TIndexes>
+constexpr WallSlots WallTable<TWidth, THeight, Indexes<TIndexes...>>::Conflicts[2][TWidth * THeight];
 
-    //  std::cerr << "turn " << turn << std::endl;
+/**
+ * @brief Size of the board known at compile time, for the inner loops of the Board
+ *
+ *  The shifts by the width, the bounds of the loops, the index offsets of the neighbor cells and the cells
+ * of the goal sides are constants, so the compiler can unroll the loops and fold them.
+ * BoardSize<0, 0> is the runtime-sized fallback, with the same interface.
+ */
+template <size_t TWidth, size_t THeight>
+struct BoardSize {
+    /// width of the board (Nb of columns, X axis)
+    static constexpr size_t width() {
+        return TWidth;
+    }
+    /// height of the board (Nb of lines, Y axis)
+    static constexpr size_t height() {
+        return THeight;
+    }
+    /// Nb of cells of the board
+    static constexpr size_t cells() {
+        return TWidth * THeight;
+    }
+    /// offset of the index of the neighbor cell into the given direction (wrapping around for left and up)
+    static constexpr size_t step(const EDirection aDirection) {
+        return Steps[aDirection];
+    }
+    /// Set of cells of the goal side of the given orientation
+    static constexpr BitBoard goal(const EDirection aOrientation) {
+        return Goals[aOrientation];
+    }
+    /// Slots of all the walls inside the empty board
+    static constexpr const WallSlots& inside() {
+        return WallTable<TWidth, THeight>::Inside;
+    }
+    /// Pair of edges blocked by the wall of the given orientation at the given index (inside the board)
+    static constexpr const BitBoard& edges(const char aOrientation, const size_t aIndex) {
+        return WallTable<TWidth, THeight>::Edges[WallSlots::side(aOrientation)][aIndex];
+    }
+    /// Slots of the walls incompatible with the wall of the given orientation at the given index (inside the board)
+    static constexpr const WallSlots& conflicts(const char aOrientation, const size_t aIndex) {
+        return WallTable<TWidth, THeight>::Conflicts[WallSlots::side(aOrientation)][aIndex];
+    }
 
-        // debug dump:
-    //  std::cerr << "matrix of walls:" << std::endl;
-    //  collisions.dump();
+private:
+    /// cells of the column aX, from the line aY to the bottom
+    static constexpr BitBoard column(const size_t aX, const size_t aY = 0) {
+        return (aY < THeight) ? BitBoard::unite(BitBoard::bit(aY * TWidth + aX), column(aX, aY + 1)) : BitBoard{};
+    }
+    /// cells of the line aY, from the column aX to the right
+    static constexpr BitBoard line(const size_t aY, const size_t aX = 0) {
+        return (aX < TWidth) ? BitBoard::unite(BitBoard::bit(aY * TWidth + aX), line(aY, aX + 1)) : BitBoard{};
+    }
 
-    //  std::cerr << "matrices of paths:" << std::endl;
-        // pathfinding for each player (taking walls into account)
-        for (auto& player : players) {
-            // re-init pathfinding data
-            player.paths.init(Cell{ std::numeric_limits<size_t>::max(), eNone });
-            // if player still playing
-            if (player.bIsAlive) {
-                // pathfinding algorithm:
-                findShortest(player.paths, collisions, player.orientation);
-                // debug dump:
-            //  player.paths.dump();
-                player.distance = player.paths.get(player.coords).distance;
-                // debug dump:
-                std::cerr << player.id << ": distance: " << player.distance << std::endl;
-            } else {
-                player.distance = std::numeric_limits<size_t>::max(); // dead player is far far away...
+    static constexpr size_t Steps[5] = { 0, 1, size_t(0) - 1, TWidth, size_t(0) - TWidth }; ///< by direction
+    static constexpr BitBoard Goals[5] = { BitBoard{}, column(TWidth - 1), column(0),
+                                           line(THeight - 1), line(0) };             ///< by orientation
+};
+template <size_t TWidth, size_t THeight>
+constexpr size_t BoardSize<TWidth, THeight>::Steps[5];
+template <size_t TWidth, size_t THeight>
+constexpr BitBoard BoardSize<TWidth, THeight>::Goals[5];
+
+/// Runtime-sized fallback of the BoardSize, with the neighbor offsets and goal sides computed once
+template <>
+struct BoardSize<0, 0> {
+    /**
+     * ctor computing the tables of the given size
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    BoardSize(const size_t aWidthX, const size_t aHeightY) :
+        mWidth(aWidthX),
+        mHeight(aHeightY),
+        mSteps{ 0, 1, size_t(0) - 1, aWidthX, size_t(0) - aWidthX },
+        mGoals{ BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{} } {
+        if ((aWidthX > 0) && (aHeightY > 0) && (aWidthX * aHeightY <= BitBoard::Bits)) { // else checked by the Board
+            for (size_t y = 0; y < aHeightY; ++y) {
+                mGoals[eRight].set(y * aWidthX + aWidthX - 1);
+                mGoals[eLeft].set(y * aWidthX);
+            }
+            for (size_t x = 0; x < aWidthX; ++x) {
+                mGoals[eDown].set((aHeightY - 1) * aWidthX + x);
+                mGoals[eUp].set(x);
             }
         }
+    }
 
-        // order of the player into the turn based on its id vs my id (it is my turn, so I have the order 0)
-        // (a dead player is always last in the ranking since its distance left is set to max => is is removed later)
-        Player::VectorPtr rankedPlayers;
-        for (size_t order = 0; order < playerCount; ++order) {
-           size_t id = (mySelf.id + order) % playerCount;
-           players[id].order = order;
-           // std::cerr << id << ": order: " << players[id].order << std::endl;
-           rankedPlayers.push_back(&players[id]);
+    /// width of the board (Nb of columns, X axis)
+    size_t width() const {
+        return mWidth;
+    }
+    /// height of the board (Nb of lines, Y axis)
+    size_t height() const {
+        return mHeight;
+    }
+    /// Nb of cells of the board
+    size_t cells() const {
+        return mWidth * mHeight;
+    }
+    /// offset of the index of the neighbor cell into the given direction (wrapping around for left and up)
+    size_t step(const EDirection aDirection) const {
+        return mSteps[aDirection];
+    }
+    /// Set of cells of the goal side of the given orientation
+    const BitBoard& goal(const EDirection aOrientation) const {
+        return mGoals[aOrientation];
+    }
+    /// Slots of all the walls inside the empty board
+    WallSlots inside() const {
+        WallSlots inside{ { BitBoard{}, BitBoard{} } };
+        for (size_t y = 0; y < mHeight; ++y) {
+            for (size_t x = 0; x < mWidth; ++x) {
+                for (const char orientation : {'H', 'V'}) {
+                    if (WallSlots::isInside(orientation, x, y, mWidth, mHeight)) {
+                        inside.slots[WallSlots::side(orientation)].set(y * mWidth + x);
+                    }
+                }
+            }
         }
-
-        // ranking of each player : distance left, and take into account the order of the player into the turn
-        std::sort(rankedPlayers.begin(), rankedPlayers.end(), Player::compare);
-        // explicit rank
-        for (size_t rank = 0; rank < rankedPlayers.size(); rank++) {
-           rankedPlayers[rank]->rank = rank;
+        return inside;
+    }
+    /// Pair of edges blocked by the wall of the given orientation at the given index (as WallSlots::edges())
+    BitBoard edges(const char aOrientation, const size_t aIndex) const {
+        BitBoard edges{};
+        setBit(edges, aIndex);
+        setBit(edges, aIndex + ((aOrientation == 'H') ? 1 : mWidth));
+        return edges;
+    }
+    /// Slots of the walls incompatible with the wall of the given orientation at the given index (as WallSlots),
+    /// set bit by bit: the constexpr expansion of BitBoard::bit() over all the words is too big for run time
+    WallSlots conflicts(const char aOrientation, const size_t aIndex) const {
+        const size_t x = aIndex % mWidth;
+        const size_t y = aIndex / mWidth;
+        WallSlots conflicts{ { BitBoard{}, BitBoard{} } };
+        if (aOrientation == 'H') {
+            setSlot(conflicts.slots[0], x - 1, y);      // left
+            setSlot(conflicts.slots[0], x, y);          // self
+            setSlot(conflicts.slots[0], x + 1, y);      // right
+            setSlot(conflicts.slots[1], x + 1, y - 1);  // upright
+        } else {
+            setSlot(conflicts.slots[0], x - 1, y + 1);  // downleft
+            setSlot(conflicts.slots[1], x, y - 1);      // up
+            setSlot(conflicts.slots[1], x, y);          // self
+            setSlot(conflicts.slots[1], x, y + 1);      // down
         }
-        // remove the dead player (always the last one if any)
-        if (!rankedPlayers.back()->bIsAlive) {
-            rankedPlayers.pop_back();
+        return conflicts;
+    }
+
+private:
+    /// set the bit at the given index, or none past the last bit (as BitBoard::bit())
+    static void setBit(BitBoard& aBits, const size_t aIndex) {
+        if (aIndex < BitBoard::Bits) {
+            aBits.set(aIndex);
         }
-        // Debug dump:
-        std::cerr << "ranks: ";
-        for (const auto& player : rankedPlayers) {
-            std::cerr << player->id << ", ";
+    }
+    /// set the slot at [X, Y], or none outside of the board (as WallSlots::slot())
+    void setSlot(BitBoard& aSlots, const size_t aX, const size_t aY) const {
+        if ((aX < mWidth) && (aY < mHeight)) {
+            aSlots.set(aY * mWidth + aX);
         }
-        std::cerr << std::endl;
+    }
 
-        // list of players before me based on ranking
-        Player::VectorPtr   playersBeforeMe;
-        if (!rankedPlayers[0]->bIsMySelf) {
-            playersBeforeMe.push_back(rankedPlayers[0]);
-            if (!rankedPlayers[1]->bIsMySelf) {
-                playersBeforeMe.push_back(rankedPlayers[0]);
-            }
+private:
+    size_t      mWidth;     ///< Nb of columns (X axis)
+    size_t      mHeight;    ///< Nb of lines (Y axis)
+    size_t      mSteps[5];  ///< offset of the neighbor cell by direction
+    BitBoard    mGoals[5];  ///< cells of the goal side by orientation
+};
+
+/// Size of the board of the game, for which the Board instantiates its inner loops
+typedef BoardSize<9, 9> GameSize;
+
+/**
+ * @brief Working distances of the cells for a search, reset in constant time by a generation counter
+ *
+ *  Each cell carries the generation in which its distance was last set: a cell of an older generation reads
+ * as unreached (Cell::Unreachable). Thus resetting the field for a new search is a single increment instead of a write
+ * of the whole board; the stamps are only cleared when the counter wraps around. The distances are of the compact
+ * type of the Cell, so that the field of the board of the game stays within a few cache lines.
+ */
+class DistanceField {
+public:
+    /**
+     * ctor allocating the field for a board of the specified size
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    DistanceField(const size_t aWidthX, const size_t aHeightY) :
+        mGeneration(1),
+        mStamps(aWidthX * aHeightY, 0),
+        mDistances(aWidthX * aHeightY, Cell::Unreachable) {
+    }
+
+    /// Start a new generation: all the cells are unreached
+    void reset() {
+        ++mGeneration;
+        if (0 == mGeneration) { // wrap around: the stamps of the oldest generations would be valid again
+            std::fill(mStamps.begin(), mStamps.end(), 0);
+            mGeneration = 1;
+        }
+    }
+
+    /// distance of the cell at the given index (Cell::Unreachable if not set since the last reset)
+    Distance get(const size_t aIndex) const {
+        return (mStamps[aIndex] == mGeneration) ? mDistances[aIndex] : Cell::Unreachable;
+    }
+    /// set the distance of the cell at the given index
+    void set(const size_t aIndex, const Distance aDistance) {
+        mStamps[aIndex]    = mGeneration;
+        mDistances[aIndex] = aDistance;
+    }
+
+private:
+    uint32_t                mGeneration;    ///< Current generation, never 0
+    std::vector<uint32_t>   mStamps;        ///< Generation in which the distance of each cell was set
+    std::vector<Distance>   mDistances;     ///< Distance of each cell, valid if of the current generation
+};
+
+/**
+ * @brief Bitboard of the walls of the board
+ *
+ * Walls are kept as two sets of blocked edges, the moves to the left and the moves up, each edge indexed
+ * by the cell on its right or lower side. A wall blocks two parallel edges, so setting or resetting it is a single
+ * bit operation on a pair of bits, and all the walls fit in two bitboards.
+ *
+ * The borders of the board are sentinel edges, permanently blocked: the left edges of the first column
+ * (that are also the right edges of the last column of the previous line) and the up edges of the first line and
+ * of a padding line below the board. So neither a neighbor test nor the shift of a whole bitboard needs to check
+ * the coordinates: the cells from which a move into each direction is possible are simply the complement
+ * of these edges.
+ *
+ * Cells are indexed line after line (index = y * width + x), so that moving right or left is a shift by one bit,
+ * and moving down or up is a shift by the width of the board.
+ */
+class Board {
+public:
+    /**
+     * ctor of an empty board without any wall
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    Board(const size_t aWidthX, const size_t aHeightY) :
+        mSize(aWidthX, aHeightY),
+        mBlockedLeft{},
+        mBlockedUp{} {
+        if ((aWidthX < 2) || (aWidthX * (aHeightY + 1) > BitBoard::Bits)) { // with the padding line
+            throw std::out_of_range("Board: size");
+        }
+        for (size_t y = 0; y <= aHeightY; ++y) {
+            mBlockedLeft.set(y * aWidthX);              // left border, and right border of the previous line
+        }
+        for (size_t x = 0; x < aWidthX; ++x) {
+            mBlockedUp.set(x);                          // top border
+            mBlockedUp.set(aHeightY * aWidthX + x);     // bottom border, on the padding line
+        }
+    }
+
+    /// width of the board (Nb of columns, X axis)
+    size_t width() const {
+        return mSize.width();
+    }
+    /// height of the board (Nb of lines, Y axis)
+    size_t height() const {
+        return mSize.height();
+    }
+    /// index of the bit of the cell at the given coordinates
+    size_t index(const Coords& aCoords) const {
+        return aCoords.y * mSize.width() + aCoords.x;
+    }
+    /// index of the slot of a wall (inside the board): horizontal ones first, then vertical ones
+    size_t slot(const Wall& aWall) const {
+        return ((aWall.orientation == 'H') ? 0 : mSize.cells()) + index(aWall.coords);
+    }
+    /// coordinates of the cell at the given bit index
+    Coords coords(const size_t aIndex) const {
+        return Coords{ aIndex % mSize.width(), aIndex / mSize.width() };
+    }
+    /// Is the board of the size of the game (then the inner loops are instantiated on the GameSize)
+    bool isGameSize() const {
+        return (mSize.width() == GameSize::width()) && (mSize.height() == GameSize::height());
+    }
+
+    /// Set (or reset) a wall into the bitboard: the pair of edges it blocks
+    void addWall(const Wall& aWall, const bool abValue = true) {
+        const size_t idx = index(aWall.coords);
+        const BitBoard edges = (isGameSize() && (idx < GameSize::cells())) ? GameSize::edges(aWall.orientation, idx)
+                                                                           : mSize.edges(aWall.orientation, idx);
+        if (aWall.orientation == 'H') { // 'H' --
+            // x,y-1 x+1,y-1
+            // x,y   x+1,y   : moves up blocked
+            setBlocked(mBlockedUp, edges, abValue);
+        } else { // .orientation == 'V'
+            // x-1,y   x,y   : moves left blocked
+            // x-1,y+1 x,y+1
+            setBlocked(mBlockedLeft, edges, abValue);
+        }
+    }
+
+    /// Set of cells of the goal side of the given orientation
+    const BitBoard& goal(const EDirection aOrientation) const {
+        return mSize.goal(aOrientation);
+    }
+
+    /**
+     * Shortest path algorithm: breadth-first search by layers of increasing distance, starting from the goal side
+     *
+     *  Each layer is computed from the previous one by shifting it into the four directions and masking it
+     * with the passable cells. In case of equal distance, go into the preferred direction (player orientation).
+     * Unreachable cells are left untouched, so aOutPaths shall be initialized with Cell::Unreachable before the call.
+     *
+     * @tparam     TMatrix      Matrix of Cell, or any other layout providing set(Coords) (see the benchmarks)
+     *
+     * @param[out] aOutPaths    Matrix of distances and directions toward the goal side
+     * @param[in]  aOrientation Orientation of the player, giving the goal side
+     */
+    template <class TMatrix>
+    void findShortest(TMatrix& aOutPaths, const EDirection aOrientation) const {
+        if (isGameSize()) {
+            findShortest(GameSize(), aOutPaths, aOrientation);
+        } else {
+            findShortest(mSize, aOutPaths, aOrientation);
+        }
+    }
+
+    /**
+     * Connectivity check: can the player reach its goal side (whatever the distance)
+     *
+     *  Flood fill of the area reachable from the player, extended by one move into the four directions at a time
+     * (shifting and masking the whole area), until it reaches the goal side or stops growing.
+     *
+     * @param[in]  aCoords      Coordinates of the player
+     * @param[in]  aOrientation Orientation of the player, giving the goal side
+     */
+    bool isReachable(const Coords& aCoords, const EDirection aOrientation) const {
+        return isGameSize() ? isReachable(GameSize(), aCoords, aOrientation)
+                            : isReachable(mSize, aCoords, aOrientation);
+    }
+
+    /**
+     * Goal-directed A* search of the distance of a player to its goal side, stopping as soon as it is reached
+     *
+     *  The heuristic is the straight distance to the goal column or line: it is consistent, so a move changes
+     * the estimated total distance f = g + h by 0, 1 or 2 only. The open cells are thus kept in a ring of three
+     * bitboards indexed by f modulo 3, popped by increasing f, without any allocation. The distances of the cells
+     * are kept into a DistanceField given by the caller, so that each search starts without clearing the board.
+     *
+     * @param[in]     aCoords      Coordinates of the player
+     * @param[in]     aOrientation Orientation of the player, giving the goal side
+     * @param[in,out] aField       Working distances of the cells, of the size of the board (reset by the search)
+     *
+     * @return distance to the goal side (max if unreachable)
+     */
+    size_t distance(const Coords& aCoords, const EDirection aOrientation, DistanceField& aField) const {
+        return isGameSize() ? distance(GameSize(), aCoords, aOrientation, aField)
+                            : distance(mSize, aCoords, aOrientation, aField);
+    }
+
+    /// Admissible heuristic: straight distance to the goal side, ignoring the walls
+    size_t heuristic(const Coords& aCoords, const EDirection aOrientation) const {
+        return heuristic(mSize, aCoords, aOrientation);
+    }
+
+    /// Is a move possible from the cell into the given direction (no wall nor border of the board, see sentinels)
+    bool isPassable(const Coords& aCoords, const EDirection aDirection) const {
+        const size_t idx = index(aCoords);
+        bool bIsPassable;
+        switch (aDirection) {
+        case eRight:    bIsPassable = !mBlockedLeft.test(idx + 1);      break;
+        case eLeft:     bIsPassable = !mBlockedLeft.test(idx);          break;
+        case eDown:     bIsPassable = !mBlockedUp.test(idx + width());  break;
+        case eUp:       bIsPassable = !mBlockedUp.test(idx);            break;
+        case eNone:
+        default:
+            throw std::logic_error("isPassable: default");
+        }
+        return bIsPassable;
+    }
+
+    /// Wall collision data of a cell (for debug dump), ignoring the borders of the board
+    Collision collision(const Coords& aCoords) const {
+        const size_t idx = index(aCoords);
+        return Collision{ (aCoords.x < width() - 1)  && mBlockedLeft.test(idx + 1),
+                          (aCoords.x > 0)            && mBlockedLeft.test(idx),
+                          (aCoords.y < height() - 1) && mBlockedUp.test(idx + width()),
+                          (aCoords.y > 0)            && mBlockedUp.test(idx) };
+    }
+
+    /// debug: dump walls of the board, using the Collision::dump() method
+    void dump() const {
+        std::cerr << " |";
+        for (size_t x = 0; x < width(); ++x) {
+            std::cerr << x << "   |";
+        }
+        std::cerr << std::endl;
+        for (size_t y = 0; y < height(); ++y) {
+            std::cerr << y << "|";
+            for (size_t x = 0; x < width(); ++x) {
+                collision(Coords{ x, y }).dump();
+            }
+            std::cerr << std::endl;
+        }
+    }
+
+private:
+    /// Shortest path algorithm, see findShortest() above, for the given size of board
+    template <class TSize, class TMatrix>
+    void findShortest(const TSize& aSize, TMatrix& aOutPaths, const EDirection aOrientation) const {
+        if (aOrientation == eNone) {
+            throw std::logic_error("shortest: default");
+        }
+        const EDirection preferences[] = { aOrientation, eRight, eLeft, eDown, eUp };
+
+        BitBoard passable[5];
+        passables(aSize, passable);
+        BitBoard frontier = aSize.goal(aOrientation);
+        BitBoard visited  = frontier;
+        write(aSize, aOutPaths, frontier, 0, eNone);
+        for (size_t distance = 1; frontier.any(); ++distance) {
+            // cells from which a move into each direction reaches the frontier
+            BitBoard toward[5];
+            toward[eNone]  = BitBoard{};
+            toward[eRight] = (frontier >> 1) & passable[eRight];
+            toward[eLeft]  = (frontier << 1) & passable[eLeft];
+            toward[eDown]  = (frontier >> aSize.width()) & passable[eDown];
+            toward[eUp]    = (frontier << aSize.width()) & passable[eUp];
+            frontier = (toward[eRight] | toward[eLeft] | toward[eDown] | toward[eUp]) & ~visited;
+            visited |= frontier;
+
+            BitBoard remaining = frontier;
+            for (const EDirection direction : preferences) {
+                const BitBoard settled = remaining & toward[direction];
+                remaining &= ~settled;
+                write(aSize, aOutPaths, settled, distance, direction);
+            }
+        }
+    }
+
+    /// Connectivity check, see isReachable() above, for the given size of board
+    template <class TSize>
+    bool isReachable(const TSize& aSize, const Coords& aCoords, const EDirection aOrientation) const {
+        const BitBoard target = aSize.goal(aOrientation);
+        BitBoard passable[5];
+        passables(aSize, passable);
+        BitBoard area{};
+        area.set(aCoords.y * aSize.width() + aCoords.x);
+        BitBoard grown = area;
+        while (grown.any() && !(area & target).any()) {
+            const BitBoard next = area | ((area & passable[eRight]) << 1) | ((area & passable[eLeft]) >> 1)
+                                       | ((area & passable[eDown]) << aSize.width())
+                                       | ((area & passable[eUp]) >> aSize.width());
+            grown = next & ~area;
+            area  = next;
+        }
+        return (area & target).any();
+    }
+
+    /// Goal-directed A* search, see distance() above, for the given size of board
+    template <class TSize>
+    size_t distance(const TSize& aSize, const Coords& aCoords, const EDirection aOrientation,
+                    DistanceField& aField) const {
+        const size_t maxDistance = std::numeric_limits<size_t>::max();
+        BitBoard opened[3] = { BitBoard{}, BitBoard{}, BitBoard{} };
+        BitBoard passable[5];
+        passables(aSize, passable);
+        aField.reset();
+        const size_t start = aCoords.y * aSize.width() + aCoords.x;
+        size_t found = maxDistance;
+        size_t estimate = heuristic(aSize, aCoords, aOrientation);
+        aField.set(start, 0);
+        opened[estimate % 3].set(start);
+        while ((found == maxDistance) && (opened[0].any() || opened[1].any() || opened[2].any())) {
+            BitBoard& open = opened[estimate % 3];
+            if (!open.any()) {
+                ++estimate;
+            } else {
+                const size_t idx      = open.pop();
+                const size_t reached  = aField.get(idx);
+                const size_t left     = heuristic(aSize, Coords{ idx % aSize.width(), idx / aSize.width() },
+                                                  aOrientation);
+                if (reached + left == estimate) { // else outdated by a shorter distance
+                    if (left == 0) {
+                        found = reached;
+                    } else {
+                        for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+                            if (passable[direction].test(idx)) {
+                                const size_t nextIdx = idx + aSize.step(direction);
+                                if (reached + 1 < aField.get(nextIdx)) {
+                                    const Coords next{ nextIdx % aSize.width(), nextIdx / aSize.width() };
+                                    aField.set(nextIdx, static_cast<Distance>(reached + 1));
+                                    const size_t total = reached + 1 + heuristic(aSize, next, aOrientation);
+                                    opened[total % 3].set(nextIdx);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    /// Admissible heuristic, see heuristic() above, for the given size of board
+    template <class TSize>
+    size_t heuristic(const TSize& aSize, const Coords& aCoords, const EDirection aOrientation) const {
+        size_t distance;
+        switch (aOrientation) {
+        case eRight:    distance = aSize.width() - 1 - aCoords.x;   break;
+        case eLeft:     distance = aCoords.x;                       break;
+        case eDown:     distance = aSize.height() - 1 - aCoords.y;  break;
+        case eUp:       distance = aCoords.y;                       break;
+        case eNone:
+        default:
+            throw std::logic_error("heuristic: default");
+        }
+        return distance;
+    }
+
+    /// Cells from which a move into each direction is possible: not blocked by a wall nor by a sentinel edge
+    template <class TSize>
+    void passables(const TSize& aSize, BitBoard (&aOutPassables)[5]) const {
+        aOutPassables[eNone]  = BitBoard{};
+        aOutPassables[eRight] = ~(mBlockedLeft >> 1);
+        aOutPassables[eLeft]  = ~mBlockedLeft;
+        aOutPassables[eDown]  = ~(mBlockedUp >> aSize.width());
+        aOutPassables[eUp]    = ~mBlockedUp;
+    }
+
+    /// Set or reset the pair of edges of a wall into the set of blocked edges
+    static void setBlocked(BitBoard& aBlocked, const BitBoard& aEdges, const bool abValue) {
+        if (abValue) {
+            aBlocked |= aEdges;
+        } else {
+            aBlocked &= ~aEdges;
+        }
+    }
+
+    /// Write the same distance and direction into the cells of the given set
+    template <class TSize, class TMatrix>
+    void write(const TSize& aSize, TMatrix& aOutPaths, BitBoard aCells,
+               const size_t aDistance, const EDirection aDirection) const {
+        const Cell cell{ static_cast<Distance>(aDistance), aDirection };
+        while (aCells.any()) {
+            const size_t idx = aCells.pop();
+            aOutPaths.set(Coords{ idx % aSize.width(), idx / aSize.width() }) = cell;
+        }
+    }
+
+private:
+    BoardSize<0, 0> mSize;          ///< runtime size of the board, with its neighbor and goal tables
+    BitBoard        mBlockedLeft;   ///< edges blocked by a wall or a border, by cell from which a move left is blocked
+    BitBoard        mBlockedUp;     ///< edges blocked by a wall or a border, by cell from which a move up is blocked
+};
+
+
+/**
+ * @brief Replacement paths of a player: distance to the goal if an edge of its shortest path is blocked by a wall
+ *
+ *  Computed in one pass from two shortest path trees sharing the path P = p0..pk of the player toward the goal:
+ * the tree of the paths of the player (from any cell toward the goal side), and a breadth-first tree from the player
+ * (forced along P). For each edge (u,v) out of P, the detour "tree path s->u, edge (u,v), tree path v->goal" avoids
+ * all the edges of P between the last cell of P on the way to u, and the first cell of P on the way from v;
+ * the replacement distance of an edge of P is the shortest of such detours (Malik, Mittal & Gupta).
+ *
+ *  A wall blocks two parallel edges: one of P, and the one next to it on one side. The shortest detour avoiding
+ * also this other edge is kept for each side, and when it is as short as the replacement distance of the edge of P
+ * (a lower bound) it is the exact distance with the wall. Else the caller shall fall back to another algorithm.
+ */
+class ReplacementPaths {
+public:
+    /**
+     * ctor allocating the working buffers for a board of the specified size
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    ReplacementPaths(const size_t aWidthX, const size_t aHeightY) :
+        mNodes(aWidthX, aHeightY),
+        mCounts(aWidthX * aHeightY + 1) {
+        mPath.reserve(aWidthX * aHeightY);
+        mDetours.reserve(aWidthX * aHeightY);
+        mQueue.reserve(aWidthX * aHeightY);
+        mSorted.reserve(aWidthX * aHeightY);
+        mStack.reserve(aWidthX * aHeightY);
+    }
+
+    /**
+     * Compute the replacement distances of all the edges of the shortest path of a player
+     *
+     * @param[in] aPaths    Matrix of distances and directions of the player toward its goal side
+     * @param[in] aBoard    Bitboard of walls
+     * @param[in] aCoords   Coordinates of the player
+     */
+    void init(const Matrix<Cell>& aPaths, const Board& aBoard, const Coords& aCoords) {
+        const size_t maxDistance = std::numeric_limits<size_t>::max();
+        mNodes.init(Node{ maxDistance, eNone, maxDistance, 0, 0, 0, 0, 0, 0 });
+        mPath.clear();
+        mDetours.clear();
+        if (aPaths.get(aCoords).distance < Cell::Unreachable) { // else the player cannot reach its goal side
+            build(aPaths, aBoard, aCoords);
+        }
+    }
+
+    /**
+     * Get the distance of the player to its goal side if a new wall is put on the board
+     *
+     * @param[in]  aWall        Wall to put on the board (compatible with the existing walls)
+     * @param[out] aDistance    Distance of the player to its goal side (max if the wall blocks the player)
+     *
+     * @return true if the distance is exact, false if unknown because all the shortest detours cross the wall
+     */
+    bool distance(const Wall& aWall, size_t& aDistance) const {
+        bool bIsExact = true;
+        Coords      from[2];
+        EDirection  direction;
+        if (aWall.orientation == 'H') {
+            from[0] = aWall.coords.up();
+            from[1] = aWall.coords.upright();
+            direction = eDown;
+        } else {
+            from[0] = aWall.coords.left();
+            from[1] = aWall.coords.downleft();
+            direction = eRight;
+        }
+        const bool bCut0 = isOnPath(from[0], from[0].next(direction));
+        const bool bCut1 = isOnPath(from[1], from[1].next(direction));
+        if (mPath.empty()) {
+            aDistance = std::numeric_limits<size_t>::max();
+        } else if (bCut0 && bCut1) {
+            bIsExact = false;
+        } else if (bCut0 || bCut1) {
+            // the other edge is next to the cut one, on its "plus" side (x+1 or y+1) if the first edge is cut
+            const Coords& cut    = bCut0 ? from[0] : from[1];
+            const Detour& detour = mDetours[std::min(mNodes.get(cut).pathIndex,
+                                                     mNodes.get(cut.next(direction)).pathIndex)];
+            aDistance = detour.distance;
+            bIsExact  = (detour.avoiding[bCut0 ? 1 : 0] == detour.distance);
+        } else {
+            aDistance = mPath.size() - 1;
+        }
+        return bIsExact;
+    }
+
+private:
+    /// Build the two trees and the detours of each edge of P
+    void build(const Matrix<Cell>& aPaths, const Board& aBoard, const Coords& aCoords) {
+        const size_t maxDistance = std::numeric_limits<size_t>::max();
+
+        // Shortest path P of the player toward the goal side, following the directions of its paths
+        Coords coords = aCoords;
+        mPath.push_back(coords);
+        mNodes.set(coords).pathIndex = 0;
+        while (aPaths.get(coords).distance > 0) {
+            coords = coords.next(aPaths.get(coords).direction);
+            mNodes.set(coords).pathIndex = mPath.size();
+            mPath.push_back(coords);
+        }
+        const size_t length = mPath.size() - 1;
+
+        // Breadth-first tree from the player, with the parent of each cell of P forced to the preceding one
+        mQueue.clear();
+        mQueue.push_back(aCoords);
+        mNodes.set(aCoords).distance = 0;
+        for (size_t idx = 0; idx < mQueue.size(); ++idx) {
+            const Coords current  = mQueue[idx];
+            const size_t distance = mNodes.get(current).distance + 1;
+            for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+                if (aBoard.isPassable(current, direction)) {
+                    Node& next = mNodes.set(current.next(direction));
+                    if (next.distance == maxDistance) {
+                        next.distance = distance;
+                        next.parent   = opposite(direction);
+                        mQueue.push_back(current.next(direction));
+                    }
+                }
+            }
+        }
+        for (size_t index = 1; index < mPath.size(); ++index) {
+            mNodes.set(mPath[index]).parent = opposite(aPaths.get(mPath[index - 1]).direction);
+        }
+        // Index of the last cell of P on the tree path from the player, in breadth-first order (parents first)
+        for (const auto& cell : mQueue) {
+            Node& node = mNodes.set(cell);
+            if (node.pathIndex < maxDistance) {
+                node.sourceIndex = node.pathIndex;
+            } else {
+                node.sourceIndex = mNodes.get(cell.next(node.parent)).sourceIndex;
+            }
+        }
+        // Index of the first cell of P on the path toward the goal side, by increasing distance to the goal
+        sortByDistance(aPaths, mQueue, mSorted);
+        size_t order = 0;
+        for (const auto& cell : mSorted) {
+            Node& node = mNodes.set(cell);
+            if (node.pathIndex < maxDistance) {
+                node.goalIndex = node.pathIndex;
+            } else if (aPaths.get(cell).distance == 0) {
+                node.goalIndex = length;    // another cell of the goal side
+            } else {
+                node.goalIndex = mNodes.get(cell.next(aPaths.get(cell).direction)).goalIndex;
+            }
+            if (aPaths.get(cell).distance == 0) {
+                order = visit(aPaths, aBoard, cell, false, order);
+            }
+        }
+        visit(aPaths, aBoard, aCoords, true, 0);
+
+        // Shortest detours of each edge of P, over all the edges (u,v) out of P
+        mDetours.assign(length, Detour{ maxDistance, { maxDistance, maxDistance } });
+        for (const auto& cell : mQueue) {
+            const Node& node = mNodes.get(cell);
+            for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+                const Coords next = cell.next(direction);
+                if (aBoard.isPassable(cell, direction) && (!isOnPath(cell, next))) {
+                    const size_t distance = node.distance + 1 + aPaths.get(next).distance;
+                    for (size_t index = node.sourceIndex; index < mNodes.get(next).goalIndex; ++index) {
+                        Detour& detour = mDetours[index];
+                        if (distance < detour.distance) {
+                            detour.distance = distance;
+                        }
+                        // Does the detour also avoid the parallel edge next to the edge of P, on each side
+                        const Coords& a = mPath[index];
+                        const Coords& b = mPath[index + 1];
+                        for (size_t side = 0; side < 2; ++side) {
+                            if (distance < detour.avoiding[side]) {
+                                Coords sideA;
+                                Coords sideB;
+                                if (!parallel(aPaths, a, b, side, sideA, sideB)
+                                    || !isOnDetour(aPaths, cell, next, sideA, sideB)) {
+                                    detour.avoiding[side] = distance;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// Working data of a cell
+    struct Node {
+        size_t      distance;       ///< distance from the player
+        EDirection  parent;         ///< direction of the parent of the cell in the tree from the player
+        size_t      pathIndex;      ///< index of the cell on P (max if not on P)
+        size_t      sourceIndex;    ///< index of the last cell of P on the tree path from the player
+        size_t      goalIndex;      ///< index of the first cell of P on the path toward the goal side
+        size_t      sourceIn;       ///< pre-order of the cell in the tree from the player
+        size_t      sourceOut;      ///< post-order of the cell in the tree from the player
+        size_t      goalIn;         ///< pre-order of the cell in the paths toward the goal side
+        size_t      goalOut;        ///< post-order of the cell in the paths toward the goal side
+    };
+
+    /// Shortest detours of an edge of P
+    struct Detour {
+        size_t      distance;   ///< distance of the player to the goal side using the shortest detour
+        size_t      avoiding[2];///< same, with a detour avoiding also the parallel edge on the minus/plus side
+    };
+
+    /// get the opposite direction
+    static EDirection opposite(const EDirection aDirection) {
+        EDirection direction;
+        switch (aDirection) {
+        case eRight:    direction = eLeft;  break;
+        case eLeft:     direction = eRight; break;
+        case eDown:     direction = eUp;    break;
+        case eUp:       direction = eDown;  break;
+        case eNone:
+        default:
+            throw std::logic_error("opposite: default");
+        }
+        return direction;
+    }
+
+    /// Get the parallel edge next to the edge (aA, aB) on the minus (x-1 or y-1) or plus (x+1 or y+1) side
+    static bool parallel(const Matrix<Cell>& aPaths, const Coords& aA, const Coords& aB, const size_t aSide,
+                         Coords& aSideA, Coords& aSideB) {
+        bool bExists;
+        if (aA.y == aB.y) { // horizontal edge: parallel edges above and below
+            bExists = (aSide == 0) ? (aA.y > 0) : (aA.y < aPaths.height() - 1);
+            if (bExists) {
+                aSideA = (aSide == 0) ? aA.up() : aA.down();
+                aSideB = (aSide == 0) ? aB.up() : aB.down();
+            }
+        } else {            // vertical edge: parallel edges on the left and the right
+            bExists = (aSide == 0) ? (aA.x > 0) : (aA.x < aPaths.width() - 1);
+            if (bExists) {
+                aSideA = (aSide == 0) ? aA.left() : aA.right();
+                aSideB = (aSide == 0) ? aB.left() : aB.right();
+            }
+        }
+        return bExists;
+    }
+
+    /// Counting sort of the cells by increasing distance to the goal side (keeping their order at equal distance)
+    void sortByDistance(const Matrix<Cell>& aPaths, const Coords::Vector& aCells, Coords::Vector& aOutSorted) {
+        std::fill(mCounts.begin(), mCounts.end(), 0);
+        for (const auto& cell : aCells) {
+            ++mCounts.at(aPaths.get(cell).distance + 1u);
+        }
+        for (size_t distance = 1; distance < mCounts.size(); ++distance) {
+            mCounts[distance] += mCounts[distance - 1];
+        }
+        aOutSorted.resize(aCells.size());
+        for (const auto& cell : aCells) {
+            aOutSorted[mCounts[aPaths.get(cell).distance]++] = cell;
+        }
+    }
+
+    /// Depth-first numbering of a tree (iterative), from the player (aIsSource) or from a cell of the goal side
+    size_t visit(const Matrix<Cell>& aPaths, const Board& aBoard, const Coords& aRoot, const bool aIsSource,
+                 size_t aOrder) {
+        mStack.clear();
+        mStack.push_back(std::make_pair(aRoot, 0));
+        setIn(aRoot, aIsSource, aOrder++);
+        const EDirection directions[] = { eRight, eLeft, eDown, eUp };
+        while (!mStack.empty()) {
+            const Coords   cell  = mStack.back().first;
+            size_t&        child = mStack.back().second;
+            if (child < 4) {
+                const EDirection direction = directions[child++];
+                if (aBoard.isPassable(cell, direction)) {
+                    const Coords next = cell.next(direction);
+                    if (isChild(aPaths, cell, next, aIsSource)) {
+                        setIn(next, aIsSource, aOrder++);
+                        mStack.push_back(std::make_pair(next, 0));
+                    }
+                }
+            } else {
+                if (aIsSource) {
+                    mNodes.set(cell).sourceOut = aOrder++;
+                } else {
+                    mNodes.set(cell).goalOut = aOrder++;
+                }
+                mStack.pop_back();
+            }
+        }
+        return aOrder;
+    }
+
+    /// Set the pre-order of a cell in one of the trees
+    void setIn(const Coords& aCoords, const bool aIsSource, const size_t aOrder) {
+        if (aIsSource) {
+            mNodes.set(aCoords).sourceIn = aOrder;
+        } else {
+            mNodes.set(aCoords).goalIn = aOrder;
+        }
+    }
+
+    /// Is the adjacent cell aChild a child of aParent in the tree from the player (aIsSource) or toward the goal
+    bool isChild(const Matrix<Cell>& aPaths, const Coords& aParent, const Coords& aChild, const bool aIsSource) const {
+        bool bIsChild;
+        if (aIsSource) {
+            const Node& node = mNodes.get(aChild);
+            bIsChild = (node.parent != eNone) && (aChild.next(node.parent) == aParent);
+        } else {
+            const Cell& cell = aPaths.get(aChild);
+            bIsChild = (cell.direction != eNone) && (aChild.next(cell.direction) == aParent);
+        }
+        return bIsChild;
+    }
+
+    /// Is the edge (aA, aB) on the tree path from aCell up to the root, in the tree from the player or toward the goal
+    bool isOnTreePath(const Matrix<Cell>& aPaths, const Coords& aA, const Coords& aB, const Coords& aCell,
+                      const bool aIsSource) const {
+        bool bIsOnTreePath = false;
+        const Coords* pChild = nullptr;
+        if (isChild(aPaths, aA, aB, aIsSource)) {
+            pChild = &aB;
+        } else if (isChild(aPaths, aB, aA, aIsSource)) {
+            pChild = &aA;
+        }
+        if (pChild) {
+            // the edge is on the path if the cell is in the subtree of the child
+            const Node& child = mNodes.get(*pChild);
+            const Node& node  = mNodes.get(aCell);
+            if (aIsSource) {
+                bIsOnTreePath = (child.sourceIn <= node.sourceIn) && (node.sourceOut <= child.sourceOut);
+            } else {
+                bIsOnTreePath = (child.goalIn <= node.goalIn) && (node.goalOut <= child.goalOut);
+            }
+        }
+        return bIsOnTreePath;
+    }
+
+    /// Is the edge (aA, aB) crossed by the detour "tree path s->u, edge (u,v), tree path v->goal"
+    bool isOnDetour(const Matrix<Cell>& aPaths, const Coords& aU, const Coords& aV,
+                    const Coords& aA, const Coords& aB) const {
+        return (((aU == aA) && (aV == aB)) || ((aU == aB) && (aV == aA))
+            || isOnTreePath(aPaths, aA, aB, aU, true)
+            || isOnTreePath(aPaths, aA, aB, aV, false));
+    }
+
+    /// Is the edge between two adjacent cells an edge of P
+    bool isOnPath(const Coords& aA, const Coords& aB) const {
+        const size_t indexA = mNodes.get(aA).pathIndex;
+        const size_t indexB = mNodes.get(aB).pathIndex;
+        return ((indexA < std::numeric_limits<size_t>::max()) && (indexB < std::numeric_limits<size_t>::max())
+            && ((indexA + 1 == indexB) || (indexB + 1 == indexA)));
+    }
+
+private:
+    Matrix<Node>        mNodes;     ///< Working data of each cell
+    Coords::Vector      mPath;      ///< Shortest path P of the player, from its coordinates to the goal side
+    std::vector<Detour> mDetours;   ///< Shortest detours of each edge of P (edge i is between P[i] and P[i+1])
+
+    Coords::Vector      mQueue;     ///< Working queue of the breadth-first tree from the player
+    Coords::Vector      mSorted;    ///< Working cells of the tree by increasing distance to the goal side
+    std::vector<size_t> mCounts;    ///< Working counts of the cells by distance, for the sort
+    std::vector<std::pair<Coords, size_t>> mStack;  ///< Working stack of the depth-first numbering
+};
+
+/**
+ * @brief Bit-parallel breadth-first search: distances of a player with up to 64 candidate walls at once
+ *
+ *  Each candidate wall is given a bit lane: for each cell of the board, a 64 bits word holds the set of candidates
+ * for which the cell is reached, and the moves blocked by the candidates are removed lane by lane. All the candidates
+ * are then expanded together by layers of increasing distance from the player, until each lane reaches the goal side.
+ */
+class WallsKernel {
+public:
+    static const size_t Lanes = 64;     ///< Max number of candidate walls per call
+    static const size_t MinLanes = 4;   ///< Below this number of candidate walls, Board::distance() is cheaper
+
+    /**
+     * ctor allocating the working buffers for a board of the specified size
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    WallsKernel(const size_t aWidthX, const size_t aHeightY) :
+        mWidth(aWidthX),
+        mPassable(4 * aWidthX * aHeightY),
+        mReached(aWidthX * aHeightY),
+        mFrontier(aWidthX * aHeightY),
+        mNext(aWidthX * (aHeightY + 2)) {
+    }
+    /// dtor
+    ~WallsKernel();
+
+    /**
+     * Distances of a player to its goal side for each candidate wall
+     *
+     * @param[in]  aBoard       Bitboard of the walls already on the board
+     * @param[in]  aCoords      Coordinates of the player
+     * @param[in]  aOrientation Orientation of the player, giving the goal side
+     * @param[in]  aCandidates  Up to 64 candidate walls, compatible with the walls already on the board
+     * @param[out] aDistances   Distance for each candidate wall (max if the wall blocks the player)
+     */
+    void distances(const Board& aBoard, const Coords& aCoords, const EDirection aOrientation,
+                   const Wall::Vector& aCandidates, std::vector<size_t>& aDistances) {
+        if (aCandidates.size() > Lanes) {
+            throw std::out_of_range("distances: too many candidates");
+        }
+        const size_t   width = aBoard.width();
+        const size_t   cells = aBoard.width() * aBoard.height();
+        const uint64_t lanes = (aCandidates.size() < Lanes) ? ((uint64_t(1) << aCandidates.size()) - 1) : ~uint64_t(0);
+        const BitBoard goal  = aBoard.goal(aOrientation);
+
+        // Moves possible from each cell, for all lanes, then remove the ones blocked by each candidate wall
+        for (size_t idx = 0; idx < cells; ++idx) {
+            const Coords coords = aBoard.coords(idx);
+            for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+                passable(idx, direction) = aBoard.isPassable(coords, direction) ? lanes : 0;
+            }
+            mReached[idx]  = 0;
+            mFrontier[idx] = 0;
+        }
+        std::fill(mNext.begin(), mNext.end(), 0);
+        for (size_t lane = 0; lane < aCandidates.size(); ++lane) {
+            const Wall&    wall = aCandidates[lane];
+            const uint64_t mask = ~(uint64_t(1) << lane);
+            if (wall.orientation == 'H') {
+                passable(aBoard.index(wall.coords.up()),      eDown) &= mask;
+                passable(aBoard.index(wall.coords.upright()), eDown) &= mask;
+                passable(aBoard.index(wall.coords),           eUp)   &= mask;
+                passable(aBoard.index(wall.coords.right()),   eUp)   &= mask;
+            } else {
+                passable(aBoard.index(wall.coords.left()),     eRight) &= mask;
+                passable(aBoard.index(wall.coords.downleft()), eRight) &= mask;
+                passable(aBoard.index(wall.coords),            eLeft)  &= mask;
+                passable(aBoard.index(wall.coords.down()),     eLeft)  &= mask;
+            }
+        }
+
+        // Expand all the lanes together, layer after layer, from the player
+        aDistances.assign(aCandidates.size(), std::numeric_limits<size_t>::max());
+        const size_t start = aBoard.index(aCoords);
+        mReached[start]  = lanes;
+        mFrontier[start] = lanes;
+        uint64_t arrived = 0;
+        uint64_t active  = lanes;
+        for (size_t distance = 0; (active != 0) && (arrived != lanes); ++distance) {
+            // lanes reaching the goal side at this distance
+            uint64_t reaching = 0;
+            BitBoard cellsOfGoal = goal;
+            while (cellsOfGoal.any()) {
+                reaching |= mFrontier[cellsOfGoal.pop()];
+            }
+            reaching &= ~arrived;
+            arrived  |= reaching;
+            while (reaching != 0) {
+                const size_t lane = countTrailingZeros(reaching);
+                reaching &= (reaching - 1);
+                aDistances[lane] = distance;
+            }
+
+            // next layer, not yet reached (cleared while computing the previous frontier)
+            for (size_t idx = 0; idx < cells; ++idx) {
+                const uint64_t frontier = mFrontier[idx] & ~arrived;
+                if (frontier != 0) {
+                    next(idx + 1)     |= frontier & passable(idx, eRight);
+                    next(idx - 1)     |= frontier & passable(idx, eLeft);
+                    next(idx + width) |= frontier & passable(idx, eDown);
+                    next(idx - width) |= frontier & passable(idx, eUp);
+                }
+            }
+            active = 0;
+            for (size_t idx = 0; idx < cells; ++idx) {
+                mFrontier[idx] = next(idx) & ~mReached[idx];
+                mReached[idx] |= mFrontier[idx];
+                active        |= mFrontier[idx];
+                next(idx)      = 0;
+            }
+        }
+    }
+
+private:
+    /// Lanes in which a move from the cell into the given direction is possible
+    uint64_t& passable(const size_t aIndex, const EDirection aDirection) {
+        return mPassable[4 * aIndex + static_cast<size_t>(aDirection) - 1];
+    }
+    /// Lanes in which the cell is reached at the next distance, from the line above the board to the line below it
+    uint64_t& next(const size_t aIndex) {
+        return mNext[aIndex + mWidth];
+    }
+
+private:
+    size_t                  mWidth;     ///< Nb of columns of the board (X axis)
+    std::vector<uint64_t>   mPassable;  ///< Lanes in which each move is possible, 4 directions per cell
+    std::vector<uint64_t>   mReached;   ///< Lanes in which each cell has been reached
+    std::vector<uint64_t>   mFrontier;  ///< Lanes in which each cell is reached at the current distance
+    std::vector<uint64_t>   mNext;      ///< Lanes in which each cell is reached at the next distance, padded by
+                                        ///< a line above and below the board for the moves blocked by the borders
+};
+WallsKernel::~WallsKernel() = default;
+
+/// player data
+struct Player {
+    /// Vector of players
+    typedef std::vector<Player> Vector;
+    /// Vector of pointers of players (for sorting by rank)
+    typedef std::vector<Player*> VectorPtr;
+
+    /// Init the Matrix
+    Player(const size_t aWidthX, const size_t aHeightY) :
+        paths(aWidthX, aHeightY),
+        detours(aWidthX, aHeightY),
+        id(0),
+        bIsMySelf(false),
+        orientation(eNone),
+        coords(),
+        wallsLeft(0),
+        distance(0),
+        order(0),
+        rank(0),
+        bIsAlive(false) {
+    }
+    /// Copyable and movable, as if the dtor were implicit
+    Player(const Player&) = default;
+    Player(Player&&) = default;
+    Player& operator=(const Player&) = default;
+    Player& operator=(Player&&) = default;
+    /// dtor, defined out of the class (see below)
+    ~Player();
+
+    Matrix<Cell>    paths;       ///< grid for pathfinding of the player
+    ReplacementPaths detours;    ///< replacement distances if an edge of the shortest path is blocked by a wall
+    size_t          id;          ///< id of the player (implicit orientation)
+    bool            bIsMySelf;   ///< explicite shortcut for (id == myId) and/or (order == 0)
+    EDirection      orientation; ///< general direction of the path to exit (explicit orientation)
+    Coords          coords;      ///< coordinates of the player
+    size_t          wallsLeft;   ///< number of walls available for the player
+    size_t          distance;    ///< distance left to reach the destination
+    size_t          order;       ///< order of the player into the turn based on its id vs me (I am playing = order 0)
+    size_t          rank;        ///< rank based on the distance left and the order of the player
+    bool            bIsAlive;    ///< true while the player is alive
+
+    /// ranking of each player : distance left, and take into account the order of the player into the turn
+    static bool compare(const Player* apA, const Player* apB) {
+    if (apA->distance != apB->distance) {
+        return (apA->distance < apB->distance);
+    } else  {
+        return (apA->order < apB->order);
+    }
+}
+};
+/**
+ * Out of the class: its many buffers are too big for the inliner on the cold paths (-Winline).
+ * The dtors of the other holders of working buffers (WallsKernel, ShortestDag, GameState) are out of their class too.
+ */
+Player::~Player() = default;
+
+/**
+ * @brief Zobrist hash of the state of the game: xor of a pseudo-random key for each of its features
+ *
+ *  The features are the slots of the walls put on the board, the cell (or the death) and the walls left
+ * of each player, and the player to move. A change of the state toggles the keys of the features it removes
+ * and adds, so the hash is updated in O(1) on every move or wall, and equal states have equal hashes whatever
+ * the order of the changes. A key is the splitmix64 mix of its feature: no table to allocate, for any board.
+ */
+class Zobrist {
+public:
+    /// ctor of the hash of an empty state, without any feature
+    Zobrist() :
+        mHash(0),
+        mWalls(0) {
+    }
+
+    /// value of the hash
+    uint64_t get() const {
+        return mHash;
+    }
+    /// value of the hash of the walls alone (the key of the shortest paths, see PathsCache)
+    uint64_t walls() const {
+        return mWalls;
+    }
+
+    /// Put or remove a wall
+    void toggleWall(const Wall& aWall) {
+        const uint64_t wall = key(eWall, WallSlots::side(aWall.orientation), pack(aWall.coords));
+        mHash  ^= wall;
+        mWalls ^= wall;
+    }
+    /// Add or remove a player: its cell (or its death) and its walls left
+    void togglePlayer(const Player& aPlayer) {
+        mHash ^= key(ePlayer, aPlayer.id, aPlayer.bIsAlive ? pack(aPlayer.coords) : Dead);
+        mHash ^= key(eWallsLeft, aPlayer.id, aPlayer.wallsLeft);
+    }
+    /// Move a player from a cell to a neighbor one
+    void move(const size_t aId, const Coords& aFrom, const Coords& aTo) {
+        mHash ^= key(ePlayer, aId, pack(aFrom)) ^ key(ePlayer, aId, pack(aTo));
+    }
+    /// Change the walls left of a player, when putting a wall
+    void setWallsLeft(const size_t aId, const size_t aFrom, const size_t aTo) {
+        mHash ^= key(eWallsLeft, aId, aFrom) ^ key(eWallsLeft, aId, aTo);
+    }
+    /// Add or remove the player to move
+    void toggleTurn(const size_t aId) {
+        mHash ^= key(eTurn, aId, 0);
+    }
+
+private:
+    /// Kinds of features of the state
+    enum EFeature {
+        eWall,      ///< slot of a wall (id: 0 for 'H', 1 for 'V')
+        ePlayer,    ///< cell of a player (id of the player)
+        eWallsLeft, ///< walls left of a player (id of the player)
+        eTurn       ///< player to move (id of the player)
+    };
+
+    static constexpr uint64_t Dead = (uint64_t(1) << 52) - 1;   ///< cell of a dead player, out of any board
+
+    /// value of the cell at [X, Y] (on 52 bits, for boards up to 2^26-1 cells wide and high)
+    static uint64_t pack(const Coords& aCoords) {
+        return ((static_cast<uint64_t>(aCoords.y) & 0x3FFFFFF) << 26) | (static_cast<uint64_t>(aCoords.x) & 0x3FFFFFF);
+    }
+
+    /// key of a feature: splitmix64 mix of its kind, its id and its value, a bijection of the distinct features
+    static uint64_t key(const EFeature aFeature, const size_t aId, const uint64_t aValue) {
+        uint64_t z = ((static_cast<uint64_t>(aFeature) << 60) ^ (static_cast<uint64_t>(aId) << 52) ^ aValue)
+                   + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t    mHash;  ///< xor of the keys of the features of the state
+    uint64_t    mWalls; ///< xor of the keys of the walls of the state
+};
+constexpr uint64_t Zobrist::Dead;
+
+/**
+ * @brief Cache of the shortest paths toward each goal side, keyed by the hash of the walls of the board
+ *
+ *  The shortest paths of a player only depend on the walls and on its goal side, not on its position: on a turn
+ * without any new wall, they are all found into the cache instead of searched again. The least recently used entry
+ * is evicted, tracked by a stamp of last use on each one. All the entries are allocated once by the ctor.
+ */
+class PathsCache {
+public:
+    static const size_t Entries = 8; ///< Nb of entries: the goal sides of 4 players with the last 2 sets of walls
+
+    /**
+     * ctor allocating the entries for a board of the specified size
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    PathsCache(const size_t aWidthX, const size_t aHeightY) :
+        mClock(0),
+        mHits(0),
+        mMisses(0),
+        mEntries(Entries, Entry(aWidthX, aHeightY)) {
+    }
+
+    /**
+     * Shortest paths toward a goal side, found into the cache, or else searched and cached
+     *
+     * @param[in] aBoard        Bitboard of the walls of the board
+     * @param[in] aWallsHash    Hash of these walls (see Zobrist::walls())
+     * @param[in] aOrientation  Goal side of the player
+     *
+     * @return Shortest paths of each cell of the board toward the goal side (valid until the next call)
+     */
+    const Matrix<Cell>& get(const Board& aBoard, const uint64_t aWallsHash, const EDirection aOrientation) {
+        Entry* pEntry = nullptr;
+        Entry* pOldest = &mEntries[0];
+        for (auto& entry : mEntries) {
+            if ((entry.orientation == aOrientation) && (entry.wallsHash == aWallsHash)) {
+                pEntry = &entry;
+            } else if (entry.lastUse < pOldest->lastUse) {
+                pOldest = &entry;
+            }
+        }
+        if (nullptr != pEntry) {
+            ++mHits;
+        } else {
+            ++mMisses;
+            pEntry = pOldest; // evict the least recently used entry
+            pEntry->orientation = aOrientation;
+            pEntry->wallsHash   = aWallsHash;
+            pEntry->paths.init(Cell{ Cell::Unreachable, eNone });
+            aBoard.findShortest(pEntry->paths, aOrientation);
+        }
+        pEntry->lastUse = ++mClock;
+        return pEntry->paths;
+    }
+
+    /**
+     * Follow a wall put on the board: the paths it leaves unchanged are kept for the new set of walls,
+     * the other ones are invalidated
+     *
+     *  A wall changes the paths only if it blocks an edge between cells at different distances (one apart):
+     * the edges between cells at the same distance are on none of the shortest paths, nor elected as a direction.
+     *
+     * @param[in] aWall         Wall put on the board (inside the board)
+     * @param[in] aFromHash     Hash of the walls without the wall
+     * @param[in] aToHash       Hash of the walls with the wall
+     */
+    void addWall(const Wall& aWall, const uint64_t aFromHash, const uint64_t aToHash) {
+        // the two pairs of cells on both sides of the wall
+        Coords ends[4];
+        if (aWall.orientation == 'H') {
+            ends[0] = aWall.coords.up();
+            ends[1] = aWall.coords;
+            ends[2] = aWall.coords.upright();
+            ends[3] = aWall.coords.right();
+        } else {
+            ends[0] = aWall.coords.left();
+            ends[1] = aWall.coords;
+            ends[2] = aWall.coords.downleft();
+            ends[3] = aWall.coords.down();
+        }
+        for (auto& entry : mEntries) {
+            if ((entry.orientation != eNone) && (entry.wallsHash == aFromHash)) {
+                if ((entry.paths.get(ends[0]).distance == entry.paths.get(ends[1]).distance)
+                    && (entry.paths.get(ends[2]).distance == entry.paths.get(ends[3]).distance)) {
+                    entry.wallsHash = aToHash;
+                } else {
+                    entry.orientation = eNone;
+                    entry.lastUse     = 0;
+                }
+            }
+        }
+    }
+
+    /// Nb of shortest paths found into the cache
+    size_t hits() const {
+        return mHits;
+    }
+    /// Nb of shortest paths searched
+    size_t misses() const {
+        return mMisses;
+    }
+
+private:
+    /// Shortest paths of a goal side with a set of walls
+    struct Entry {
+        /// ctor of an empty entry, allocating its paths
+        Entry(const size_t aWidthX, const size_t aHeightY) :
+            orientation(eNone),
+            wallsHash(0),
+            lastUse(0),
+            paths(aWidthX, aHeightY) {
+        }
+
+        EDirection      orientation;    ///< goal side of the paths (eNone for an empty entry)
+        uint64_t        wallsHash;      ///< hash of the walls of the board
+        size_t          lastUse;        ///< stamp of the last use of the entry
+        Matrix<Cell>    paths;          ///< shortest paths of each cell toward the goal side
+    };
+
+private:
+    size_t              mClock;     ///< stamp of the last use of any entry
+    size_t              mHits;      ///< Nb of shortest paths found into the cache
+    size_t              mMisses;    ///< Nb of shortest paths searched
+    std::vector<Entry>  mEntries;   ///< entries of the cache
+};
+
+/**
+ * @brief Legal slots of the walls: one bit per slot (coordinates and orientation), cleared when a wall is put
+ *
+ *  A wall put on the board makes illegal its own slot and the slots of the walls overlapping or crossing it,
+ * (see WallSlots::conflicts()): the legality of a new wall is then a single bit test instead of a scan
+ * of all the walls of the board, and the legal walls can be enumerated by popping the bits of each orientation.
+ * Slots are indexed as the cells of the Board (index = y * width + x), by orientation.
+ */
+class LegalWalls {
+public:
+    /**
+     * ctor of the legal slots of an empty board: all the walls inside the board
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    LegalWalls(const size_t aWidthX, const size_t aHeightY) :
+        mSize(aWidthX, aHeightY),
+        mLegal(isGameSize() ? GameSize::inside() : mSize.inside()) {
+    }
+
+    /// Make illegal the slots of the walls incompatible with a wall put on the board (table lookup, see WallSlots)
+    void addWall(const Wall& aWall) {
+        if ((aWall.coords.x < mSize.width()) && (aWall.coords.y < mSize.height())) {
+            const size_t idx = aWall.coords.y * mSize.width() + aWall.coords.x;
+            if (isGameSize()) {
+                clear(GameSize::conflicts(aWall.orientation, idx));
+            } else {
+                clear(mSize.conflicts(aWall.orientation, idx));
+            }
+        }
+    }
+
+    /// Is a new wall legal: inside the board, and compatible with all the walls put on the board
+    bool isLegal(const Wall& aWall) const {
+        return (aWall.coords.x < mSize.width()) && (aWall.coords.y < mSize.height())
+            && mLegal.slots[WallSlots::side(aWall.orientation)].test(aWall.coords.y * mSize.width() + aWall.coords.x);
+    }
+
+    /// Set of the legal slots of the walls of the given orientation
+    const BitBoard& slots(const char aOrientation) const {
+        return mLegal.slots[WallSlots::side(aOrientation)];
+    }
+
+private:
+    /// Is the board of the size of the game, with its tables of walls computed at compile time
+    bool isGameSize() const {
+        return (mSize.width() == GameSize::width()) && (mSize.height() == GameSize::height());
+    }
+
+    /// Make illegal the slots of a set of conflicts
+    void clear(const WallSlots& aConflicts) {
+        mLegal.slots[0] &= ~aConflicts.slots[0];
+        mLegal.slots[1] &= ~aConflicts.slots[1];
+    }
+
+private:
+    BoardSize<0, 0> mSize;      ///< runtime size of the board
+    WallSlots       mLegal;     ///< Legal slots of the horizontal walls, then of the vertical walls
+};
+
+/**
+ * @brief Shortest path DAG of a player: all the edges lying on at least one of its shortest paths to the goal side
+ *
+ *  Moving from the player to any neighbor at a distance one less from the goal side enumerates exactly the edges
+ * of all its shortest paths. A wall cutting none of them cannot increase the distance of the player, so these are
+ * the only walls worth evaluating, and a wall cutting some of them still has an equal-length bypass
+ * if the goal side can be reached in the DAG without crossing it.
+ *
+ *  The DAG is layered by the distance from the player, and each shortest path crosses each layer exactly once:
+ * the critical edges, dominating the goal side (crossed by all the shortest paths), are the ones alone in their layer.
+ * A wall blocking one of them is guaranteed to increase the distance of the player.
+ *  The walls are listed layer after layer, but the ones cutting the stored path of the player are numbered along it,
+ * so that the evaluation keeps the choice of the stored path among walls of equal score.
+ */
+class ShortestDag {
+public:
+    /**
+     * ctor allocating the working buffers for a board of the specified size
+     *
+     * @param aWidthX    Nb of columns (X coordinate)
+     * @param aHeightY   Nb of lines   (Y coordinate)
+     */
+    ShortestDag(const size_t aWidthX, const size_t aHeightY) :
+        mWidth(aWidthX),
+        mStart(0),
+        mLength(Cell::Unreachable),
+        mEdges{ BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{} },
+        mCritical{ BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{}, BitBoard{} },
+        mPathOrder(2 * aWidthX * aHeightY, 0),
+        mIsListed(2 * aWidthX * aHeightY, false),
+        mIsVisited(aWidthX * aHeightY, false) {
+        mWalls.reserve(2 * aWidthX * aHeightY);
+        mLayerEdges.reserve(aWidthX * aHeightY);
+        mQueue.reserve(aWidthX * aHeightY);
+    }
+    /// dtor
+    ~ShortestDag();
+
+    /**
+     * Build the DAG of the shortest paths of a player
+     *
+     * @param[in]  aPaths       Matrix of distances and directions of the player toward its goal side
+     * @param[in]  aBoard       Bitboard of walls (of the size given to the ctor)
+     * @param[in]  aCoords      Coordinates of the player
+     */
+    void init(const Matrix<Cell>& aPaths, const Board& aBoard, const Coords& aCoords) {
+        const BitBoard empty{};
+        std::fill(mIsListed.begin(), mIsListed.end(), false);
+        std::fill(mIsVisited.begin(), mIsVisited.end(), false);
+        mLayerEdges.clear();
+        mQueue.clear();
+
+        mWidth  = aBoard.width();
+        mStart  = aBoard.index(aCoords);
+        mLength = aPaths.get(aCoords).distance;
+        mWalls.clear();
+        for (auto& edges : mEdges) {
+            edges = empty;
+        }
+        for (auto& critical : mCritical) {
+            critical = empty;
+        }
+        std::fill(mPathOrder.begin(), mPathOrder.end(), 0);
+        Coords step = aCoords;
+        size_t order = 0;
+        while ((aPaths.get(step).distance > 0) && (aPaths.get(step).distance < Cell::Unreachable)) {
+            // number the two walls of each move of the stored path (the last one wins for a wall cutting two moves)
+            const EDirection direction = aPaths.get(step).direction;
+            Wall walls[2];
+            blockingWalls(step, direction, walls);
+            for (const auto& wall : walls) {
+                if (WallSlots::isInside(wall.orientation, wall.coords.x, wall.coords.y,
+                                        aBoard.width(), aBoard.height())) {
+                    mPathOrder[aBoard.slot(wall)] = ++order;
+                }
+            }
+            step = step.next(direction);
+        }
+        if (mLength < Cell::Unreachable) {
+            mLayerEdges.assign(mLength, 0);
+            mQueue.push_back(aCoords);
+            mIsVisited[aBoard.index(aCoords)] = true;
+        }
+        for (size_t idx = 0; idx < mQueue.size(); ++idx) {
+            const Coords coords   = mQueue[idx];
+            const size_t distance = aPaths.get(coords).distance;
+            for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+                if ((distance > 0) && aBoard.isPassable(coords, direction)
+                    && (aPaths.get(coords.next(direction)).distance == distance - 1)) {
+                    // edge of the DAG: list the two walls blocking it
+                    mEdges[direction].set(aBoard.index(coords));
+                    ++mLayerEdges[mLength - distance];
+                    Wall walls[2];
+                    blockingWalls(coords, direction, walls);
+                    for (const auto& wall : walls) {
+                        if (WallSlots::isInside(wall.orientation, wall.coords.x, wall.coords.y,
+                                                aBoard.width(), aBoard.height())
+                            && (!mIsListed[aBoard.slot(wall)])) {
+                            mIsListed[aBoard.slot(wall)] = true;
+                            mWalls.push_back(wall);
+                        }
+                    }
+
+                    const Coords next = coords.next(direction);
+                    if (!mIsVisited[aBoard.index(next)]) {
+                        mIsVisited[aBoard.index(next)] = true;
+                        mQueue.push_back(next);
+                    }
+                }
+            }
+        }
+        // critical edges: alone in their layer
+        for (const auto& coords : mQueue) {
+            const size_t distance = aPaths.get(coords).distance;
+            for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+                if ((distance > 0) && (mLayerEdges[mLength - distance] == 1)
+                    && mEdges[direction].test(aBoard.index(coords))) {
+                    mCritical[direction].set(aBoard.index(coords));
+                }
+            }
+        }
+    }
+
+    /// Walls (inside the board) cutting at least one edge of the DAG, by increasing distance from the player
+    const Wall::Vector& walls() const {
+        return mWalls;
+    }
+
+    /// Does the wall block a critical edge of the DAG (then it increases the distance of the player)
+    bool isCritical(const Board& aBoard, const Wall& aWall) const {
+        bool bIsCritical = false;
+        BitBoard blocked[5];
+        block(aBoard, aWall, blocked);
+        for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+            bIsCritical |= (mCritical[direction] & blocked[direction]).any();
+        }
+        return bIsCritical;
+    }
+
+    /// Position of the wall along the stored path of the player, from 1 next to the player (0 if not cutting it)
+    size_t pathOrder(const Board& aBoard, const Wall& aWall) const {
+        return mPathOrder[aBoard.slot(aWall)];
+    }
+
+    /// Is there a path of the DAG reaching the goal side without crossing the wall (then the distance is unchanged)
+    bool hasBypass(const Board& aBoard, const Wall& aWall) const {
+        BitBoard blocked[5];
+        block(aBoard, aWall, blocked);
+        BitBoard edges[5];
+        for (const EDirection direction : {eRight, eLeft, eDown, eUp}) {
+            edges[direction] = mEdges[direction] & ~blocked[direction];
+        }
+        // flood the DAG layer after layer, from the player
+        BitBoard frontier{};
+        if (mLength < Cell::Unreachable) {
+            frontier.set(mStart);
+        }
+        for (size_t layer = 0; (layer < mLength) && frontier.any(); ++layer) {
+            frontier = ((frontier & edges[eRight]) << 1)      | ((frontier & edges[eLeft]) >> 1)
+                     | ((frontier & edges[eDown])  << mWidth) | ((frontier & edges[eUp])   >> mWidth);
+        }
+        return frontier.any();
+    }
+
+    /// get the two walls blocking the move from the cell into the given direction
+    static void blockingWalls(const Coords& aCoords, const EDirection aDirection, Wall (&aOutWalls)[2]) {
+        switch (aDirection) {
+        case eRight:
+            aOutWalls[0] = Wall{aCoords.right(), 'V'};
+            aOutWalls[1] = Wall{aCoords.upright(), 'V'};
+            break;
+        case eLeft:
+            aOutWalls[0] = Wall{aCoords, 'V'};
+            aOutWalls[1] = Wall{aCoords.up(), 'V'};
+            break;
+        case eDown:
+            aOutWalls[0] = Wall{aCoords.down(), 'H'};
+            aOutWalls[1] = Wall{aCoords.downleft(), 'H'};
+            break;
+        case eUp:
+            aOutWalls[0] = Wall{aCoords, 'H'};
+            aOutWalls[1] = Wall{aCoords.left(), 'H'};
+            break;
+        case eNone:
+        default:
+            throw std::logic_error("walls: default");
+            break;
+        }
+    }
+
+private:
+    /// get the moves blocked by a wall, for each direction
+    static void block(const Board& aBoard, const Wall& aWall, BitBoard (&aOutBlocked)[5]) {
+        for (auto& blocked : aOutBlocked) {
+            blocked = BitBoard{};
+        }
+        if (aWall.orientation == 'H') {
+            aOutBlocked[eDown].set(aBoard.index(aWall.coords.up()));
+            aOutBlocked[eDown].set(aBoard.index(aWall.coords.upright()));
+            aOutBlocked[eUp].set(aBoard.index(aWall.coords));
+            aOutBlocked[eUp].set(aBoard.index(aWall.coords.right()));
+        } else {
+            aOutBlocked[eRight].set(aBoard.index(aWall.coords.left()));
+            aOutBlocked[eRight].set(aBoard.index(aWall.coords.downleft()));
+            aOutBlocked[eLeft].set(aBoard.index(aWall.coords));
+            aOutBlocked[eLeft].set(aBoard.index(aWall.coords.down()));
+        }
+    }
+
+private:
+    size_t              mWidth;         ///< Nb of columns of the board (X axis)
+    size_t              mStart;         ///< Index of the cell of the player
+    size_t              mLength;        ///< Distance of the player to the goal side (number of layers of edges)
+    BitBoard            mEdges[5];      ///< Cells from which a move into each direction is an edge of the DAG
+    BitBoard            mCritical[5];   ///< Cells from which a move into each direction is a critical edge
+    Wall::Vector        mWalls;         ///< Walls cutting at least one edge of the DAG
+    std::vector<size_t> mPathOrder;     ///< Position of each wall slot along the stored path of the player (0 if none)
+
+    std::vector<bool>   mIsListed;      ///< Working flag of each wall slot: wall listed into mWalls
+    std::vector<bool>   mIsVisited;     ///< Working flag of each cell: cell queued
+    std::vector<size_t> mLayerEdges;    ///< Working number of edges from each layer to the next one
+    Coords::Vector      mQueue;         ///< Working queue of the cells of the DAG, layer after layer
+};
+ShortestDag::~ShortestDag() = default;
+
+/// Evaluation of impacts of the placement of a wall
+struct Evaluation {
+    bool    bIsValid;       ///< Does this structure represent a valide result (no player blocked)
+    Wall    wall;           ///< Wall to evaluate
+    size_t  impactOnFirst;  ///< Increase of distance on the shortest path of the first player [O:
+    size_t  impactOnMySelf; ///< Increase of distance on the shortest path of myself
+    size_t  impactOnOther;  ///< Increase of distance on the shortest path of the other players if any
+    bool    bIsCritical;    ///< Pre-scoring: the wall blocks an edge crossed by all shortest paths of the first player
+    size_t  pathOrder;      ///< Position of the wall along the stored path of the first player (see ShortestDag)
+
+    /// score of the impacts of the wall
+    int64_t score() const {
+        return (100 * static_cast<int64_t>(impactOnFirst)) - (70 * static_cast<int64_t>(impactOnMySelf))
+             + (40 * static_cast<int64_t>(impactOnOther));
+    }
+
+    /// evaluation of the best result to keep (equal is to keep the LAST best eval along the path, ie next to the exit)
+    bool operator<= (const Evaluation& aEvaluation) const {
+        return (score() < aEvaluation.score())
+            || ((score() == aEvaluation.score()) && (pathOrder <= aEvaluation.pathOrder));
+    }
+};
+
+/**
+ * @brief State of the board at each turn, and working buffers of the search of the best wall, reused from turn to turn
+ *
+ *  Allocated once at startup for the size of the board and the number of players, with the capacity of each vector
+ * reserved for its max size (all the slots of walls of the board): from turn to turn the vectors are only cleared,
+ * so that a turn does not allocate anything and its duration does not depend on the allocator.
+ */
+struct GameState {
+    /**
+     * ctor allocating the state and the working buffers for a board and a number of players
+     *
+     * @param aWidthX       Nb of columns (X coordinate)
+     * @param aHeightY      Nb of lines   (Y coordinate)
+     * @param aPlayerCount  Nb of players (2 to 4)
+     */
+    GameState(const size_t aWidthX, const size_t aHeightY, const size_t aPlayerCount) :
+        board(aWidthX, aHeightY),
+        legalWalls(aWidthX, aHeightY),
+        pathsCache(aWidthX, aHeightY),
+        bIsPut(2 * aWidthX * aHeightY, false),
+        wallsKernel(aWidthX, aHeightY),
+        firstDag(aWidthX, aHeightY),
+        field(aWidthX, aHeightY) {
+        const size_t slots = 2 * aWidthX * aHeightY;
+        walls.reserve(slots);
+        rankedPlayers.reserve(aPlayerCount);
+        playersBeforeMe.reserve(aPlayerCount);
+        candidates.reserve(slots);
+        bIsCritical.reserve(slots);
+        distances.reserve(slots * aPlayerCount);
+        unknownWalls.reserve(slots);
+        unknownIndexes.reserve(slots);
+        batch.reserve(WallsKernel::Lanes);
+        kernelDistances.reserve(WallsKernel::Lanes);
+    }
+    /// dtor
+    ~GameState();
+
+    /**
+     * Put a wall read from the input, unless already on the board: the walls only ever get added during a game,
+     * so the board, the legal slots, the hash and the cached paths are updated by the new walls only
+     *
+     * @param[in] aWall     Wall read from the input: rejected if not inside the board, before touching anything
+     *
+     * @return true if the wall is new
+     */
+    bool addWall(const Wall& aWall) {
+        bool bIsNew = false;
+        if (((aWall.orientation != 'H') && (aWall.orientation != 'V'))
+            || !WallSlots::isInside(aWall.orientation, aWall.coords.x, aWall.coords.y, board.width(), board.height())) {
+            std::cerr << "invalid wall[" << aWall.coords << "] '" << aWall.orientation << "'\n";
+        } else if (!bIsPut[board.slot(aWall)]) {
+            bIsNew = true;
+            const uint64_t wallsHash = hash.walls();
+            bIsPut[board.slot(aWall)] = true;
+            walls.push_back(aWall);
+            board.addWall(aWall);
+            legalWalls.addWall(aWall);
+            hash.toggleWall(aWall);
+            pathsCache.addWall(aWall, wallsHash, hash.walls());
+        }
+        return bIsNew;
+    }
+
+    Board               board;              ///< Bitboard of the walls of the board
+    Wall::Vector        walls;              ///< Walls of the board
+    LegalWalls          legalWalls;         ///< Slots of the walls still legal on the board
+    Zobrist             hash;               ///< Hash of the walls, the players and the player to move
+    PathsCache          pathsCache;         ///< Shortest paths toward each goal side, by set of walls
+    std::vector<bool>   bIsPut;             ///< Is a wall on the board, by slot (see Board::slot())
+    Player::VectorPtr   rankedPlayers;      ///< Alive players, by rank
+    Player::VectorPtr   playersBeforeMe;    ///< Players ranked before me
+
+    WallsKernel         wallsKernel;        ///< Bit-parallel distances of a player with up to 64 candidate walls
+    ShortestDag         firstDag;           ///< Shortest path DAG of the first player
+    DistanceField       field;              ///< Working distances of the single A* queries
+    Wall::Vector        candidates;         ///< Candidate walls to evaluate
+    std::vector<bool>   bIsCritical;        ///< Is each candidate wall blocking a critical edge of the first player
+    std::vector<size_t> distances;          ///< Distance of each player with each candidate wall [wall][player id]
+    Wall::Vector        unknownWalls;       ///< Candidate walls of unknown distance for a player
+    std::vector<size_t> unknownIndexes;     ///< Index of each of these walls into the candidates
+    Wall::Vector        batch;              ///< Batch of up to 64 of these walls for the kernel
+    std::vector<size_t> kernelDistances;    ///< Distances of the player with each wall of the batch
+};
+GameState::~GameState() = default;
+
+/**
+ * @brief Compact position of a game on the board of the size of the game, trivially copyable, for a lookahead search
+ *
+ *  Holds the cells and the walls left of the players, the walls put on the board, the player to move and the hash
+ * (64 bytes with the bitboards of the 9x9 board). make() plays a move and unmake() takes it back in a few
+ * nanoseconds, updating the hash; the overlap of a wall with the walls of the board is a lookup into the tables
+ * of the GameSize. The connectivity of the players after a wall is still the job of the Board.
+ */
+class Position {
+public:
+    static const size_t MaxPlayers = 4; ///< Max nb of players
+
+    /// Move of the player to move: a step into a direction, or else a wall
+    struct Move {
+        EDirection  direction;  ///< direction of the step, or eNone to put the wall
+        Wall        wall;       ///< wall to put, when no direction
+    };
+
+    /**
+     * ctor of the position of a turn
+     *
+     * @param[in] aPlayers          Players of the game (2 to 4), on the board of the size of the game
+     * @param[in] aWalls            Walls of the board
+     * @param[in] aPlayerToMove     Id of the player to move
+     */
+    Position(const Player::Vector& aPlayers, const Wall::Vector& aWalls, const size_t aPlayerToMove) :
+        mWalls{ { BitBoard{}, BitBoard{} } },
+        mHash(),
+        mCells{ Dead, Dead, Dead, Dead },
+        mWallsLeft{ 0, 0, 0, 0 },
+        mPlayerCount(static_cast<uint8_t>(aPlayers.size())),
+        mPlayerToMove(static_cast<uint8_t>(aPlayerToMove)) {
+        if ((aPlayers.size() > MaxPlayers) || (aPlayerToMove >= aPlayers.size())) {
+            throw std::logic_error("Position: players");
+        }
+        for (const auto& player : aPlayers) {
+            if (player.bIsAlive) {
+                mCells[player.id] = static_cast<uint8_t>(player.coords.y * GameSize::width() + player.coords.x);
+            }
+            mWallsLeft[player.id] = static_cast<uint8_t>(player.wallsLeft);
+            mHash.togglePlayer(player);
+        }
+        for (const auto& wall : aWalls) {
+            mWalls.slots[WallSlots::side(wall.orientation)].set(index(wall));
+            mHash.toggleWall(wall);
+        }
+        mHash.toggleTurn(aPlayerToMove);
+    }
+
+    /// Zobrist hash of the position (equal to the one of the GameState of the same turn)
+    uint64_t hash() const {
+        return mHash.get();
+    }
+    /// Id of the player to move
+    size_t playerToMove() const {
+        return mPlayerToMove;
+    }
+    /// Is the player still playing
+    bool isAlive(const size_t aId) const {
+        return (Dead != mCells[aId]);
+    }
+    /// Coordinates of an alive player
+    Coords coords(const size_t aId) const {
+        return toCoords(mCells[aId]);
+    }
+    /// Nb of walls left of the player
+    size_t wallsLeft(const size_t aId) const {
+        return mWallsLeft[aId];
+    }
+    /// Is a new wall inside the board and compatible with all the walls of the position (not its connectivity)
+    bool isLegal(const Wall& aWall) const {
+        bool bIsLegal = (aWall.coords.x < GameSize::width()) && (aWall.coords.y < GameSize::height());
+        if (bIsLegal) {
+            const size_t idx = index(aWall);
+            const WallSlots& conflicts = GameSize::conflicts(aWall.orientation, idx);
+            bIsLegal = GameSize::inside().slots[WallSlots::side(aWall.orientation)].test(idx)
+                    && !(conflicts.slots[0] & mWalls.slots[0]).any() && !(conflicts.slots[1] & mWalls.slots[1]).any();
+        }
+        return bIsLegal;
+    }
+
+    /// Play a move of the player to move (a legal one), and pass the turn to the next alive player
+    void make(const Move& aMove) {
+        const size_t id = mPlayerToMove;
+        if (eNone != aMove.direction) {
+            const size_t from = mCells[id];
+            const size_t to   = from + GameSize::step(aMove.direction);
+            mHash.move(id, toCoords(from), toCoords(to));
+            mCells[id] = static_cast<uint8_t>(to);
+        } else {
+            mWalls.slots[WallSlots::side(aMove.wall.orientation)].set(index(aMove.wall));
+            mHash.toggleWall(aMove.wall);
+            mHash.setWallsLeft(id, mWallsLeft[id], mWallsLeft[id] - 1u);
+            --mWallsLeft[id];
+        }
+        setPlayerToMove(nextPlayer(1));
+    }
+
+    /// Take back the last move played by make(), given again
+    void unmake(const Move& aMove) {
+        setPlayerToMove(nextPlayer(mPlayerCount - 1u)); // the previous alive player
+        const size_t id = mPlayerToMove;
+        if (eNone != aMove.direction) {
+            const size_t to   = mCells[id];
+            const size_t from = to - GameSize::step(aMove.direction);
+            mHash.move(id, toCoords(to), toCoords(from));
+            mCells[id] = static_cast<uint8_t>(from);
+        } else {
+            mWalls.slots[WallSlots::side(aMove.wall.orientation)].reset(index(aMove.wall));
+            mHash.toggleWall(aMove.wall);
+            mHash.setWallsLeft(id, mWallsLeft[id], mWallsLeft[id] + 1u);
+            ++mWallsLeft[id];
+        }
+    }
+
+private:
+    static constexpr uint8_t Dead = 0xFF; ///< cell of a dead player
+
+    /// index of the slot of a wall (see WallSlots)
+    static size_t index(const Wall& aWall) {
+        return aWall.coords.y * GameSize::width() + aWall.coords.x;
+    }
+    /// coordinates of the cell at the given index
+    static Coords toCoords(const size_t aIndex) {
+        return Coords{ aIndex % GameSize::width(), aIndex / GameSize::width() };
+    }
+
+    /// Id of the first alive player after the player to move, at the given offset or beyond
+    size_t nextPlayer(const size_t aOffset) const {
+        size_t id = (mPlayerToMove + aOffset) % mPlayerCount;
+        while (!isAlive(id) && (id != mPlayerToMove)) {
+            id = (id + aOffset) % mPlayerCount;
+        }
+        return id;
+    }
+    /// Pass the turn to another player
+    void setPlayerToMove(const size_t aId) {
+        mHash.toggleTurn(mPlayerToMove);
+        mHash.toggleTurn(aId);
+        mPlayerToMove = static_cast<uint8_t>(aId);
+    }
+
+private:
+    WallSlots   mWalls;                 ///< Slots of the walls of the board
+    Zobrist     mHash;                  ///< Hash of the position
+    uint8_t     mCells[MaxPlayers];     ///< Index of the cell of each player (Dead if not playing)
+    uint8_t     mWallsLeft[MaxPlayers]; ///< Nb of walls left of each player
+    uint8_t     mPlayerCount;           ///< Nb of players (2 to 4)
+    uint8_t     mPlayerToMove;          ///< Id of the player to move
+};
+constexpr uint8_t Position::Dead;
+static_assert(std::is_trivially_copyable<Position>::value, "Position shall be copied as raw memory");
+static_assert((BitBoard::Bits > 128) || (sizeof(Position) <= 64), "Position shall fit into a cache line");
+static_assert(GameSize::cells() < 255, "the cells of the Position are indexed on 8 bits");
+
+/// Evaluation of all impacts of a wall, from the distance of each alive player with the wall, keeping the best
+void evalWall(const Player::Vector& aPlayers, const Wall& aWall, const bool abIsCritical,
+              const size_t* apDistances, const size_t aPathOrder, Evaluation& aBestEval) {
+    Evaluation eval;
+    eval.bIsValid       = true;
+    eval.impactOnFirst  = 0;
+    eval.impactOnMySelf = 0;
+    eval.impactOnOther  = 0;
+    eval.bIsCritical    = abIsCritical;
+    eval.pathOrder      = aPathOrder;
+
+    for (const auto& player : aPlayers) {
+        if (player.bIsAlive) {
+            const size_t nextDistance = apDistances[player.id];
+            if (nextDistance < std::numeric_limits<size_t>::max()) {
+                std::cerr << "nextDistance(" << player.id << " [" << player.coords << "])="
+                          << nextDistance << std::endl;
+                if (player.rank == 0) {
+                    eval.impactOnFirst    = (nextDistance - player.distance);
+                    std::cerr << "impactOnFirst(" << nextDistance << "-" << player.distance
+                              << ")=" << eval.impactOnFirst << std::endl;
+                } else if (player.bIsMySelf) {
+                    eval.impactOnMySelf   = (nextDistance - player.distance);
+                    std::cerr << "impactOnMySelf(" << nextDistance << "-" << player.distance
+                        << ")=" << eval.impactOnMySelf << std::endl;
+                } else {
+                    eval.impactOnOther   += (nextDistance - player.distance);
+                    std::cerr << "impactOnOther(" << nextDistance << "-" << player.distance
+                        << ")=" << eval.impactOnOther << std::endl;
+                }
+            } else {
+                eval.bIsValid = false;
+                break;
+            }
+        }
+    }
+    // evaluation of the result to keep the best (keep the last one, ie near the exit)
+    if ((eval.bIsValid) && (eval.impactOnFirst > 0) && ((aBestEval <= eval) || (!aBestEval.bIsValid))) {
+        std::cerr << "new best[" << aWall.coords << "] " << aWall.orientation << (eval.bIsCritical ? " critical" : "")
+            << " (" << eval.impactOnFirst << ";" << eval.impactOnMySelf << ";" << eval.impactOnOther << ")\n";
+        eval.wall = aWall;
+        aBestEval = eval;
+        std::cerr << "new best[" << aBestEval.wall.coords << "] " << aBestEval.wall.orientation << "\n";
+        std::cerr << "new best(" << aBestEval.impactOnFirst << ";" << aBestEval.impactOnMySelf
+            << ";" << aBestEval.impactOnOther << ")\n";
+    }
+}
+
+/**
+ * Evaluation of all impacts of the walls cutting the shortest paths of the first player, keeping the best one
+ *
+ *  Pre-scoring on the shortest path DAG of the first player: a wall blocking a critical edge is known to increase
+ * its distance, so it is ranked first, else a wall with an equal-length bypass cannot, so it is skipped without any
+ * further scoring.
+ * Then a wall blocking any player is illegal, so it is dropped by a bitboard flood fill before any distance work.
+ *  The distance of each player with each wall is looked up from its replacement paths, and the remaining ones
+ * (when all the shortest detours cross the wall) are computed together by batches of 64 with the bit-parallel kernel,
+ * or by single goal-directed A* queries if there are only a few of them.
+ *
+ * @param[in,out] aState    Board, legal walls and shortest path DAG of the first player, and working buffers
+ * @param[in]     aPlayers  Players of the game, with their replacement paths
+ * @param[in,out] aBestEval Best evaluation of a wall, kept if none is better
+ */
+void evalWalls(GameState& aState, const Player::Vector& aPlayers, Evaluation& aBestEval) {
+    const Board&        board = aState.board;
+    const ShortestDag&  firstDag = aState.firstDag;
+    Wall::Vector&       walls = aState.candidates;
+
+    // keep only the walls increasing the distance of the first player, compatible with the ones on the board,
+    // and not blocking any player (connectivity check, before any distance work)
+    Board nextBoard = board;
+    walls.clear();
+    aState.bIsCritical.clear();
+    for (const bool bIsCriticalRank : {true, false}) {      // the critical walls first
+        for (const auto& candidate : firstDag.walls()) {
+            const bool bIsCriticalCandidate = firstDag.isCritical(board, candidate);
+            if ((bIsCriticalCandidate == bIsCriticalRank)
+                && (bIsCriticalCandidate || !firstDag.hasBypass(board, candidate))
+                && aState.legalWalls.isLegal(candidate)) {
+                bool bIsValid = true;
+                nextBoard.addWall(candidate, true);     // set
+                for (const auto& player : aPlayers) {
+                    if ((player.bIsAlive) && (!nextBoard.isReachable(player.coords, player.orientation))) {
+                        std::cerr << "blocking[" << candidate.coords << "] " << candidate.orientation
+                                  << " player " << player.id << std::endl;
+                        bIsValid = false;
+                        break;
+                    }
+                }
+                nextBoard.addWall(candidate, false);    // reset
+                if (bIsValid) {
+                    walls.push_back(candidate);
+                    aState.bIsCritical.push_back(bIsCriticalCandidate);
+                }
+            }
+        }
+    }
+
+    // distances of each alive player with each wall [wall * players + player id]
+    std::vector<size_t>& distances = aState.distances;
+    Wall::Vector&        unknownWalls = aState.unknownWalls;
+    std::vector<size_t>& unknownIndexes = aState.unknownIndexes;
+    distances.assign(walls.size() * aPlayers.size(), 0);
+    for (const auto& player : aPlayers) {
+        if (player.bIsAlive) {
+            unknownWalls.clear();
+            unknownIndexes.clear();
+            for (size_t idx = 0; idx < walls.size(); ++idx) {
+                if (!player.detours.distance(walls[idx], distances[idx * aPlayers.size() + player.id])) {
+                    unknownWalls.push_back(walls[idx]);
+                    unknownIndexes.push_back(idx);
+                }
+            }
+            if (unknownWalls.size() < WallsKernel::MinLanes) {
+                // a few single A* queries are cheaper than the setup of the kernel
+                for (size_t idx = 0; idx < unknownWalls.size(); ++idx) {
+                    nextBoard.addWall(unknownWalls[idx], true);     // set
+                    distances[unknownIndexes[idx] * aPlayers.size() + player.id] =
+                        nextBoard.distance(player.coords, player.orientation, aState.field);
+                    nextBoard.addWall(unknownWalls[idx], false);    // reset
+                }
+                unknownWalls.clear();
+            }
+            for (size_t first = 0; first < unknownWalls.size(); first += WallsKernel::Lanes) {
+                const size_t last = std::min(first + WallsKernel::Lanes, unknownWalls.size());
+                aState.batch.assign(unknownWalls.begin() + first, unknownWalls.begin() + last);
+                aState.wallsKernel.distances(board, player.coords, player.orientation, aState.batch,
+                                             aState.kernelDistances);
+                for (size_t idx = first; idx < last; ++idx) {
+                    distances[unknownIndexes[idx] * aPlayers.size() + player.id] = aState.kernelDistances[idx - first];
+                }
+            }
+        }
+    }
+
+    // evaluation of each wall, the critical ones first, the ties being kept in the order of the stored path
+    for (size_t idx = 0; idx < walls.size(); ++idx) {
+        evalWall(aPlayers, walls[idx], aState.bIsCritical[idx], &distances[idx * aPlayers.size()],
+                 firstDag.pathOrder(board, walls[idx]), aBestEval);
+    }
+}
+
+
+#ifndef THEGREATESCAPE_BENCHMARK // the benchmarks include this file and provide their own main()
+/**
+ * Read the players and the walls of a turn, updating the hash and putting the new walls on the board
+ *
+ * @param[in,out] aPlayers  Players of the game
+ * @param[in,out] aState    State of the game: board, legal walls and hash
+ *
+ * @return true if the whole turn was read, false at the end of the input
+ */
+bool readTurn(Player::Vector& aPlayers, GameState& aState) {
+    gAllocations.reset(Allocations::eParse);
+    // wait and read players data
+    for (size_t id = 0; id < aPlayers.size(); ++id) {
+        Player& player = aPlayers[id];
+
+        int x = -1; // x-coordinate of the player
+        int y = -1; // y-coordinate of the player
+        size_t wallsLeft = 0; // number of walls available for the player
+        std::cin >> x >> y >> wallsLeft; std::cin.ignore();
+
+        aState.hash.togglePlayer(player); // remove the previous state of the player
+        player.id          = id;               // redundant with the index, but useful
+        player.orientation = fromPlayerId(id); // redundant with the id, but useful
+        player.wallsLeft   = wallsLeft;
+
+        // if player still playing
+        if ((x >= 0) && (y >= 0)) {
+            player.coords.x = static_cast<size_t>(x);
+            player.coords.y = static_cast<size_t>(y);
+            player.bIsAlive = true;
+
+            /* debug:
+            if (player.bIsMySelf) {
+                std::cerr << "myself(" << player.id << "): [" << player.coords.x
+                          << ", " << player.coords.y << "] (wallsLeft=" << player.wallsLeft << ")\n";
+            } else {
+                std::cerr << "player(" << player.id << "): [" << player.coords.x
+                          << ", " << player.coords.y << "] (wallsLeft=" << player.wallsLeft << ")\n";
+            }
+            */
+        } else {
+            player.bIsAlive = false;
+            std::cerr << "_dead_(" << id << "): [" << x << ", " << y << "]\n";
+        }
+        aState.hash.togglePlayer(player);
+    }
+
+    // read walls data
+    size_t wallCount = 0; // number of walls on the board
+    std::cin >> wallCount; std::cin.ignore();
+
+    // all the walls are listed again at each turn: put only the new ones on the board kept from turn to turn
+    for (size_t idx = 0; idx < wallCount; ++idx) {
+        Wall wall;
+        std::cin >> wall.coords.x >> wall.coords.y >> wall.orientation; std::cin.ignore();
+        if (std::cin && aState.addWall(wall)) {
+            std::cerr << "new wall[" << wall.coords << "] '" << wall.orientation << "'\n";
+        }
+    }
+    std::cerr << "hash: " << std::hex << aState.hash.get() << std::dec << std::endl;
+
+    return !std::cin.fail();
+}
+
+/**
+ * Auto-generated code below aims at helping you parse
+ * the standard input according to the problem statement.
+ *
+ * @return 0
+ */
+int main() {
+    size_t w; // width of the board
+    size_t h; // height of the board
+    size_t playerCount; // number of players (2 to 4)
+    size_t myId; // id of my player (0 = 1st player, 1 = 2nd player, ...)
+    std::cin >> w >> h >> playerCount >> myId; std::cin.ignore();
+
+    // all players statuses (constructed in place, to keep the capacity of their working buffers)
+    Player::Vector players;
+    players.reserve(playerCount);
+    for (size_t id = 0; id < playerCount; ++id) {
+        players.emplace_back(w, h);
+    }
+    Player& mySelf = players[myId];
+    // board and working buffers of the turns, allocated once
+    GameState state(w, h, playerCount);
+    Player::VectorPtr& rankedPlayers = state.rankedPlayers;
+    Player::VectorPtr& playersBeforeMe = state.playersBeforeMe;
+    mySelf.bIsMySelf = true;
+    // hash of the initial state, then updated by each change read at each turn (it is always my turn)
+    for (const auto& player : players) {
+        state.hash.togglePlayer(player);
+    }
+    state.hash.toggleTurn(myId);
+    Measure measure;
+    bool bModeWall = false; // memory to keep putting walls after the first one
+
+    // game loop, until the end of the input
+    Board& board = state.board;
+    for (size_t turn = 0; (turn < 100) && readTurn(players, state); ++turn) {
+        // Start-counting the time after the input are all read
+        measure.start();
+        gAllocations.start(Allocations::ePathfinding);
+
+    //  std::cerr << "turn " << turn << std::endl;
+
+        // debug dump:
+    //  std::cerr << "matrix of walls:" << std::endl;
+    //  board.dump();
+
+    //  std::cerr << "matrices of paths:" << std::endl;
+        // pathfinding for each player (taking walls into account)
+        for (auto& player : players) {
+            // if player still playing
+            if (player.bIsAlive) {
+                // pathfinding algorithm (only on a new set of walls, else the paths of the cache):
+                player.paths = state.pathsCache.get(board, state.hash.walls(), player.orientation);
+                // debug dump:
+            //  player.paths.dump();
+                player.distance = player.paths.get(player.coords).distance;
+                // debug dump:
+                std::cerr << player.id << ": distance: " << player.distance << std::endl;
+            } else {
+                player.paths.init(Cell{ Cell::Unreachable, eNone });
+                player.distance = std::numeric_limits<size_t>::max(); // dead player is far far away...
+            }
+        }
+        std::cerr << "paths cache: " << state.pathsCache.hits() << " hits, "
+                  << state.pathsCache.misses() << " misses" << std::endl;
+
+        gAllocations.start(Allocations::eRanking);
+        // order of the player into the turn based on its id vs my id (it is my turn, so I have the order 0)
+        // (a dead player is always last in the ranking since its distance left is set to max => is is removed later)
+        rankedPlayers.clear();
+        for (size_t order = 0; order < playerCount; ++order) {
+           size_t id = (mySelf.id + order) % playerCount;
+           players[id].order = order;
+           // std::cerr << id << ": order: " << players[id].order << std::endl;
+           rankedPlayers.push_back(&players[id]);
+        }
+
+        // ranking of each player : distance left, and take into account the order of the player into the turn
+        std::sort(rankedPlayers.begin(), rankedPlayers.end(), Player::compare);
+        // explicit rank
+        for (size_t rank = 0; rank < rankedPlayers.size(); rank++) {
+           rankedPlayers[rank]->rank = rank;
+        }
+        // remove the dead players (always the last ones if any)
+        while (!rankedPlayers.empty() && !rankedPlayers.back()->bIsAlive) {
+            rankedPlayers.pop_back();
+        }
+        // Debug dump:
+        std::cerr << "ranks: ";
+        for (const auto& player : rankedPlayers) {
+            std::cerr << player->id << ", ";
+        }
+        std::cerr << std::endl;
+
+        // list of players before me based on ranking
+        playersBeforeMe.clear();
+        if (!rankedPlayers[0]->bIsMySelf) {
+            playersBeforeMe.push_back(rankedPlayers[0]);
+            if (!rankedPlayers[1]->bIsMySelf) {
+                playersBeforeMe.push_back(rankedPlayers[0]);
+            }
         }
 
+        gAllocations.start(Allocations::eWalls);
         bool bNewWall = false;
 
         // Only put a wall if :
@@ -731,59 +2957,27 @@ int main() {
                     //    I am the last one (2nd out of 2 or 3d out of 3 alive players)
                     // OR I am the 2nd out of 3 AND the 3rd player is at a distance > 2
                     if ((rankedPlayers.back()->bIsMySelf) || (rankedPlayers.back()->distance > 2) || (bModeWall)) {
-                        Matrix<Collision>   nextCollisions = collisions;
-                        Matrix<Cell>        nextPaths(w, h);
                         Evaluation          bestEval;
                         bestEval.bIsValid       = false;
                         bestEval.impactOnFirst  = 0;
                         bestEval.impactOnMySelf = 0;
                         bestEval.impactOnOther  = 0;
+                        bestEval.bIsCritical    = false;
+                        bestEval.pathOrder      = 0;
 
                         bModeWall = true; // memory to keep putting walls
 
-                        // iterate on the path of the first player
-                        Coords coords   = firstPlayer.coords;
-                        size_t distance = firstPlayer.distance;
-                        while (distance > 0) {
-                            const Cell& cell = firstPlayer.paths.get(coords);
-                            std::cerr << "path[" << coords << "]" << std::endl;
-
-                            // calculate all blocking walls
-                            switch (cell.direction) {
-                            case eRight:
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords.right(), 'V'}, bestEval);
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords.upright(), 'V'}, bestEval);
-                                break;
-                            case eLeft:
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords, 'V'}, bestEval);
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords.up(), 'V'}, bestEval);
-                                break;
-                            case eDown:
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords.down(), 'H'}, bestEval);
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords.downleft(), 'H'}, bestEval);
-                                break;
-                            case eUp:
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords, 'H'}, bestEval);
-                                evalWall(nextPaths, nextCollisions, players, walls,
-                                         Wall{coords.left(), 'H'}, bestEval);
-                                break;
-                            case eNone:
-                            default:
-                                throw std::logic_error("walls: default");
-                                break;
+                        // replacement distances of the shortest path of each player
+                        for (auto& player : players) {
+                            if (player.bIsAlive) {
+                                player.detours.init(player.paths, board, player.coords);
                             }
-
-                            coords   = coords.next(cell.direction);
-                            const Cell& nextCell = firstPlayer.paths.get(coords);
-                            distance = nextCell.distance;
                         }
+
+                        // list the walls cutting any of the shortest paths of the first player
+                        state.firstDag.init(firstPlayer.paths, board, firstPlayer.coords);
+                        evalWalls(state, players, bestEval);
+
                         // if a best evaluation is available, put the wall
                         if (bestEval.bIsValid) {
                             std::cerr << "best eval (" << bestEval.impactOnFirst << ";" << bestEval.impactOnMySelf
@@ -805,7 +2999,14 @@ int main() {
 
         // Calculate the time elapsed since start of this turn
         std::cerr << std::fixed << measure.get() << "ms\n";
+#ifdef THEGREATESCAPE_TRACK_ALLOCATIONS
+        gAllocations.dump();
+        if (gAllocations.count() > 0) { // all the buffers are reserved at startup: a turn shall allocate nothing
+            throw std::logic_error("main: allocation in a turn");
+        }
+#endif // THEGREATESCAPE_TRACK_ALLOCATIONS
     }
 
     return 0;
 }
+#endif // THEGREATESCAPE_BENCHMARK
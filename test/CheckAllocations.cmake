@@ -0,0 +1,44 @@
+# Copyright (c) 2015 Sébastien Rombauts (sebastien.rombauts@gmail.com)
+#
+# Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+# or copy at http://opensource.org/licenses/MIT)
+
+# Play a recorded game with the bot built with THEGREATESCAPE_TRACK_ALLOCATIONS:
+#   cmake -DBINARY=<bot> -DINPUT=<game> -P CheckAllocations.cmake
+# Fails if the bot does not exit normally at the end of the input, if it does not play each turn of the game
+# (no more, no less), or if any turn allocates.
+execute_process(COMMAND ${BINARY} INPUT_FILE ${INPUT} OUTPUT_QUIET ERROR_VARIABLE debug RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${BINARY} < ${INPUT} failed (${result}):\n${debug}")
+endif (NOT result EQUAL 0)
+
+# one line "allocations: parse N (...) pathfinding N (...) ranking N (...) walls N (...)" per turn
+string(REGEX MATCHALL "allocations: [^\n]*" turns "${debug}")
+list(LENGTH turns count)
+
+# turns of the game: "w h playerCount myId", then for each turn the players, the number of walls and the walls
+# (the empty lines, as the one ending a file, are skipped)
+file(STRINGS ${INPUT} lines REGEX ".")
+list(GET lines 0 header)
+string(REGEX REPLACE "^[0-9]+ [0-9]+ ([0-9]+) [0-9]+$" "\\1" playerCount "${header}")
+list(LENGTH lines lineCount)
+set(expected 0)
+set(line 1)
+while (line LESS lineCount)
+    math(EXPR line "${line} + ${playerCount}")
+    list(GET lines ${line} wallCount)
+    math(EXPR line "${line} + 1 + ${wallCount}")
+    math(EXPR expected "${expected} + 1")
+endwhile (line LESS lineCount)
+if (NOT count EQUAL expected)
+    message(FATAL_ERROR "${BINARY} < ${INPUT}: ${count} turns played instead of ${expected}")
+endif (NOT count EQUAL expected)
+
+set(turn 0)
+foreach (allocations ${turns})
+    if (allocations MATCHES "(parse|pathfinding|ranking|walls) [1-9]")
+        message(FATAL_ERROR "${BINARY} < ${INPUT}: turn ${turn} ${allocations}")
+    endif (allocations MATCHES "(parse|pathfinding|ranking|walls) [1-9]")
+    math(EXPR turn "${turn} + 1")
+endforeach (allocations)
+message(STATUS "${count} turns without allocation")
@@ -0,0 +1,17 @@
+# Copyright (c) 2015 Sébastien Rombauts (sebastien.rombauts@gmail.com)
+#
+# Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+# or copy at http://opensource.org/licenses/MIT)
+
+# Replay a game of the corpus with the bot, and compare its commands with the recorded ones:
+#   cmake -DBINARY=<bot> -DINPUT=<game.txt> -DEXPECTED=<game.expected> -P CheckReplay.cmake
+# Fails if the bot does not exit normally at the end of the input, or if any of its commands differs.
+execute_process(COMMAND ${BINARY} INPUT_FILE ${INPUT} OUTPUT_VARIABLE commands ERROR_QUIET RESULT_VARIABLE result)
+if (NOT result EQUAL 0)
+    message(FATAL_ERROR "${BINARY} < ${INPUT} failed (${result})")
+endif (NOT result EQUAL 0)
+
+file(READ ${EXPECTED} expected)
+if (NOT commands STREQUAL expected)
+    message(FATAL_ERROR "${BINARY} < ${INPUT}: commands differ from ${EXPECTED}:\n${commands}")
+endif (NOT commands STREQUAL expected)